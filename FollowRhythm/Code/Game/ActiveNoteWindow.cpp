@@ -0,0 +1,118 @@
+#include "Game/ActiveNoteWindow.hpp"
+#include "Game/NoteTable.hpp"
+#include "Game/MonotonicArena.hpp"
+#include "Game/HoldIntervalIndex.hpp"
+#include "Game/GameplayConstants.hpp"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////////
+uint32_t ActiveNoteWindow::GetCapacityForTable(NoteTable const& table)
+{
+    //render begin times are sorted, so the oldest live note only moves forward
+    uint32_t maxSpan = 1;
+    uint32_t oldest = 0;
+    for (uint32_t i = 0; i < table.count; i++) {
+        uint32_t spawnMS = table.renderBeginMS[i];
+        while (oldest < i && table.renderEndMS[oldest] <= spawnMS) {
+            oldest++;
+        }
+        uint32_t span = i - oldest + 1;
+        maxSpan = span > maxSpan ? span : maxSpan;
+    }
+
+    uint32_t capacity = 1;
+    while (capacity < maxSpan) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::Init(NoteTable const& table, MonotonicArena& arena)
+{
+    uint32_t capacity = GetCapacityForTable(table);
+    m_slots = arena.AllocateArray<uint32_t>(capacity);
+    m_mask = capacity - 1;
+    Reset();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::Clear()
+{
+    *this = ActiveNoteWindow();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::Reset(uint32_t spawnCursor)
+{
+    m_head = 0;
+    m_count = 0;
+    m_spawnCursor = spawnCursor;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::Seek(NoteTable const& table, HoldIntervalIndex const& holds, uint32_t elapsedMS)
+{
+    //singles have a short render span, binary search past the ones that are over
+    //holds that are on screen but not started yet must land after the cursor too, whatever the singles are
+    uint32_t searchSpanMS = NOTE_RENDER_MAX_TIME_MS + NOTE_SCORE_DELTA_TIME_MS;
+    searchSpanMS = table.maxSingleRenderSpanMS > searchSpanMS ? table.maxSingleRenderSpanMS : searchSpanMS;
+    uint32_t firstCandidate = 0;
+    if (elapsedMS >= searchSpanMS) {
+        uint32_t earliestBeginMS = elapsedMS - searchSpanMS + 1;
+        uint32_t const* renderBegins = table.renderBeginMS;
+        firstCandidate = (uint32_t)(std::lower_bound(renderBegins, renderBegins + table.count, earliestBeginMS) - renderBegins);
+    }
+
+    Reset(firstCandidate);
+    if (m_slots == nullptr) {
+        return;
+    }
+
+    //older holds already started, they are visible exactly while elapsedMS is inside them
+    holds.ForEachOverlap(elapsedMS, elapsedMS + 1, [this, firstCandidate](uint32_t noteIndex) {
+        if (noteIndex < firstCandidate) {
+            PushNote(noteIndex);
+        }
+    });
+    SpawnNewNotes(table, elapsedMS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::SpawnNewNotes(NoteTable const& table, uint32_t elapsedMS)
+{
+    if (m_slots == nullptr) {
+        return;
+    }
+
+    uint32_t const* renderBegins = table.renderBeginMS;
+    uint32_t const* renderEnds = table.renderEndMS;
+    while (m_spawnCursor < table.count && renderBegins[m_spawnCursor] <= elapsedMS) {
+        if (renderEnds[m_spawnCursor] > elapsedMS) {
+            PushNote(m_spawnCursor);
+        }
+        m_spawnCursor++;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::PushNote(uint32_t noteIndex)
+{
+    m_slots[(m_head + m_count) & m_mask] = noteIndex;
+    m_count++;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::RetireSlot(size_t slot)
+{
+    m_slots[(m_head + slot) & m_mask] = ACTIVE_NOTE_TOMBSTONE;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ActiveNoteWindow::TrimRetired()
+{
+    while (m_count > 0 && m_slots[m_head] == ACTIVE_NOTE_TOMBSTONE) {
+        m_head = (m_head + 1) & m_mask;
+        m_count--;
+    }
+}
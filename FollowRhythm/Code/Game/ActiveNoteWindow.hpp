@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct NoteTable;
+class MonotonicArena;
+class HoldIntervalIndex;
+
+constexpr uint32_t ACTIVE_NOTE_TOMBSTONE = 0xFFFFFFFF;
+
+//visible notes of a song as a fixed ring of note indices in spawn order
+//retired notes leave a tombstone until every older slot is retired too
+//capacity is the widest span of slots the chart can produce, so the ring never overflows
+class ActiveNoteWindow
+{
+public:
+    static uint32_t GetCapacityForTable(NoteTable const& table);
+
+    void Init(NoteTable const& table, MonotonicArena& arena);
+    void Clear();
+    void Reset(uint32_t spawnCursor = 0);   //drops every slot, next spawn starts at spawnCursor
+    void Seek(NoteTable const& table, HoldIntervalIndex const& holds, uint32_t elapsedMS);  //rebuilds the window for any time
+
+    //pushes notes whose render window opened by elapsedMS, skips the ones already over
+    void SpawnNewNotes(NoteTable const& table, uint32_t elapsedMS);
+    void RetireSlot(size_t slot);
+    void TrimRetired();     //drops tombstones at the front, call after a retire sweep
+
+    size_t   GetSlotCount() const                { return m_count; }
+    uint32_t GetNoteInSlot(size_t slot) const    { return m_slots[(m_head + slot) & m_mask]; }
+    uint32_t GetSpawnCursor() const              { return m_spawnCursor; }
+    uint32_t GetCapacity() const                 { return m_mask + 1; }
+    bool     IsEmpty() const                     { return m_count == 0; }
+
+private:
+    void PushNote(uint32_t noteIndex);
+
+private:
+    uint32_t* m_slots = nullptr;
+    uint32_t m_mask = 0;
+    uint32_t m_head = 0;
+    uint32_t m_count = 0;
+    uint32_t m_spawnCursor = 0;
+};
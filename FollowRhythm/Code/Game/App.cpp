@@ -1,6 +1,8 @@
 #include "Game/App.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/FrameVertexArena.hpp"
+#include "Game/GameAudioSystem.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
@@ -9,7 +11,6 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Input/InputSystem.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Platform/Window.hpp"
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
@@ -33,8 +34,9 @@ void App::Startup()
     g_theRenderer = new RenderContext();		//initialize global RendererContext pointer
     g_theInput = new InputSystem();
     g_theEvents = new EventSystem();
-    g_theAudio = new AudioSystem();
+    g_theAudio = new GameAudioSystem();
     g_theConsole = new DevConsole(g_theInput);
+    g_theFrameVerts = new FrameVertexArena();
     m_theGame = new Game();
 
     //set up window
@@ -69,6 +71,9 @@ void App::Shutdown()
     delete m_theGame;
     m_theGame = nullptr;
 
+    delete g_theFrameVerts;
+    g_theFrameVerts = nullptr;
+
     delete g_theConsole;
     g_theConsole = nullptr;
 
@@ -122,6 +127,7 @@ void App::BeginFrame()
 	g_theConsole->BeginFrame();
 	g_theRenderer->BeginFrame();	
 	g_theAudio->BeginFrame();	
+    g_theFrameVerts->BeginFrame();
 
     DebugRenderBeginFrame();
 }
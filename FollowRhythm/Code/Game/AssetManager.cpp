@@ -11,6 +11,17 @@
 static Rgba8 sWarmColor = Rgba8(255, 153, 102);
 static Rgba8 sColdColor = Rgba8(51, 204, 255);
 
+static char const* sTexturePaths[NUM_TEXTURE_IDS] = {
+    "data/images/base.png",
+    "data/images/buttons-2d/progress.png",
+    "data/images/gamepad.png",
+    "data/images/minus.png",
+    "data/images/plus.png",
+    "data/images/buttons-2d/6-new.png",
+    "data/images/buttons-2d/7.png",
+    "data/images/particle.png",
+};
+
 AssetManager* AssetManager::gAssetManager = nullptr;
 
 //////////////////////////////////////////////////////////////////////////
@@ -44,6 +55,10 @@ AssetManager::AssetManager(char const* assetFile)
     XmlElement* root = assetDoc.RootElement();
     GUARANTEE_OR_DIE(root!=nullptr, Stringf("Root element of %s is null", assetFile));
 
+    for (int i = 0; i < NUM_TEXTURE_IDS; i++) {
+        m_textures[i] = g_theRenderer->CreateOrGetTextureFromFile(sTexturePaths[i]);
+    }
+
     //backgrounds
     XmlElement const* backgrounds = root->FirstChildElement("Backgrounds");
     std::string folder = ParseXmlAttribute(*backgrounds, "folder","");
@@ -55,9 +70,9 @@ AssetManager::AssetManager(char const* assetFile)
         Background bgStruct;
         bgStruct.floatyBG = folder+subfolder+floaty;
         bgStruct.mainBG = folder+subfolder+mainFile;
+        bgStruct.floatyTexture = g_theRenderer->CreateOrGetTextureFromFile(bgStruct.floatyBG.c_str());
+        bgStruct.mainTexture = g_theRenderer->CreateOrGetTextureFromFile(bgStruct.mainBG.c_str());
         m_backgrounds.push_back(bgStruct);
-        g_theRenderer->CreateOrGetTextureFromFile(bgStruct.floatyBG.c_str());
-        g_theRenderer->CreateOrGetTextureFromFile(bgStruct.mainBG.c_str());
         bg = bg->NextSiblingElement("Background");
     }
 
@@ -78,6 +93,7 @@ AssetManager::AssetManager(char const* assetFile)
         IntVec2 layout = ParseXmlAttribute(*fires, "layout", IntVec2(1,1));
         m_fireSheet = new SpriteSheet(*defaultTex, layout);
         m_fireAnim = new SpriteAnimDefinition(*m_fireSheet, 0, 59, 3.f);
+        m_fireUVs.Bake(*m_fireAnim, 60, 3.f, true);
     }
 
     //monsters
@@ -93,15 +109,20 @@ AssetManager::AssetManager(char const* assetFile)
         anims = ParseXmlAttribute(*mon, "anim", anims);
         if (type == "single") {            
             m_singleMonsterAnim = new SpriteAnimDefinition(*m_monsterSheet, anims, 1.f);
+            m_singleMonsterUVs.Bake(*m_singleMonsterAnim, (int)anims.size(), 1.f, true);
             float scoreDeltaTime = (float)NOTE_SCORE_DELTA_TIME_MS *.001f;
             anims = ParseXmlAttribute(*mon, "attack", anims);
             m_singleAttackAnim = new SpriteAnimDefinition(*m_monsterSheet, anims, scoreDeltaTime, eSpriteAnimPlaybackType::ONCE);
+            m_singleAttackUVs.Bake(*m_singleAttackAnim, (int)anims.size(), scoreDeltaTime, false);
             anims = ParseXmlAttribute(*mon, "finish", anims);
             m_singleFinishAnim = new SpriteAnimDefinition(*m_monsterSheet, anims, scoreDeltaTime, eSpriteAnimPlaybackType::ONCE);
+            m_singleFinishUVs.Bake(*m_singleFinishAnim, (int)anims.size(), scoreDeltaTime, false);
         }
         else if (type == "multi") {
             m_multiMonsterAnim = new SpriteAnimDefinition(*m_monsterSheet, anims, 1.f);
+            m_multiMonsterUVs.Bake(*m_multiMonsterAnim, (int)anims.size(), 1.f, true);
             m_monsterTailIndex = ParseXmlAttribute(*mon, "tail", 0);
+            m_monsterTailUVs.BakeSprite(*m_monsterSheet, m_monsterTailIndex);
         }
         mon = mon->NextSiblingElement("Monster");
     }
@@ -110,7 +131,7 @@ AssetManager::AssetManager(char const* assetFile)
 }
 
 //////////////////////////////////////////////////////////////////////////
-Background AssetManager::GetRandomBackgroundPaths() const
+Background const& AssetManager::GetRandomBackground() const
 {
     int maxIndex = (int)m_backgrounds.size()-1;
     int index = g_theRNG->RollRandomIntInRange(0,maxIndex);
@@ -126,10 +147,65 @@ FireFlicker AssetManager::GetRandomFireFlicker() const
 }
 
 //////////////////////////////////////////////////////////////////////////
-void AssetManager::GetFireFlickerUVsAtTime(Vec2& uvMins, Vec2& uvMaxs, unsigned int milliSeconds) const
+SpriteUVs const& AssetManager::GetFireFlickerUVsAtTime(unsigned int milliSeconds) const
+{
+    return m_fireUVs.GetUVsAtTime((float)milliSeconds*.001f, false);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SpriteAnimUVTable::Bake(SpriteAnimDefinition const& anim, int frameCount, float durationSeconds, bool isLooping)
+{
+    m_uvs.clear();
+    m_frameCount = frameCount < 1 ? 1 : frameCount;
+    m_framesPerSecond = durationSeconds > 0.f ? (float)m_frameCount / durationSeconds : 0.f;
+    m_isLooping = isLooping;
+
+    //sample the middle of every frame so float error never lands on a neighbour
+    float secondsPerFrame = durationSeconds / (float)m_frameCount;
+    for (int i = 0; i < m_frameCount; i++) {
+        Vec2 uvMins, uvMaxs;
+        anim.GetSpriteDefAtTime(((float)i + .5f) * secondsPerFrame).GetUVs(uvMins, uvMaxs);
+        AddFrame(uvMins, uvMaxs);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SpriteAnimUVTable::BakeSprite(SpriteSheet const& sheet, int spriteIndex)
 {
-    float elapsedSeconds = (float)milliSeconds*.001f;
-    m_fireAnim->GetSpriteDefAtTime(elapsedSeconds).GetUVs(uvMins,uvMaxs);
+    m_uvs.clear();
+    m_frameCount = 1;
+    m_framesPerSecond = 0.f;
+    m_isLooping = false;
+
+    Vec2 uvMins, uvMaxs;
+    sheet.GetSpriteUVs(uvMins, uvMaxs, spriteIndex);
+    AddFrame(uvMins, uvMaxs);
+}
+
+//////////////////////////////////////////////////////////////////////////
+SpriteUVs const& SpriteAnimUVTable::GetUVsAtTime(float seconds, bool isMirrored) const
+{
+    int frame = seconds > 0.f ? (int)(seconds * m_framesPerSecond) : 0;
+    if (m_isLooping) {
+        frame %= m_frameCount;
+    }
+    else {
+        frame = frame < m_frameCount ? frame : m_frameCount - 1;
+    }
+    return m_uvs[(frame << 1) + (isMirrored ? 1 : 0)];
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SpriteAnimUVTable::AddFrame(Vec2 const& uvMins, Vec2 const& uvMaxs)
+{
+    SpriteUVs frame;
+    frame.uvMins = uvMins;
+    frame.uvMaxs = uvMaxs;
+    m_uvs.push_back(frame);
+
+    frame.uvMins.x = uvMaxs.x;
+    frame.uvMaxs.x = uvMins.x;
+    m_uvs.push_back(frame);
 }
 
 //////////////////////////////////////////////////////////////////////////
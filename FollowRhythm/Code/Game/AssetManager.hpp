@@ -3,16 +3,58 @@
 #include <string>
 #include <vector>
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
 
 class SpriteSheet;
 class SpriteAnimDefinition;
 class Texture;
-struct Vec2;
+
+struct SpriteUVs
+{
+    Vec2 uvMins;
+    Vec2 uvMaxs;
+};
+
+//a sprite animation baked into one uv rect per frame at load, plain and mirrored in x
+//looking up a frame is a multiply and a table load instead of a walk through the animation
+class SpriteAnimUVTable
+{
+public:
+    void Bake(SpriteAnimDefinition const& anim, int frameCount, float durationSeconds, bool isLooping);
+    void BakeSprite(SpriteSheet const& sheet, int spriteIndex);    //still sprite, one frame
+
+    SpriteUVs const& GetUVsAtTime(float seconds, bool isMirrored) const;
+
+private:
+    void AddFrame(Vec2 const& uvMins, Vec2 const& uvMaxs);
+
+private:
+    std::vector<SpriteUVs> m_uvs;       //frame i plain at 2i, mirrored at 2i+1
+    float m_framesPerSecond = 0.f;
+    int m_frameCount = 0;
+    bool m_isLooping = false;
+};
+
+//textures drawn every frame by the menus and songs, resolved once at load so render code binds handles
+enum eTextureID
+{
+    TEXTURE_BASE = 0,
+    TEXTURE_PROGRESS,
+    TEXTURE_GAMEPAD,
+    TEXTURE_MINUS,
+    TEXTURE_PLUS,
+    TEXTURE_BUTTON,
+    TEXTURE_MUSIC_BUTTON,
+    TEXTURE_PARTICLE,
+    NUM_TEXTURE_IDS
+};
 
 struct Background
 {
     std::string mainBG;
     std::string floatyBG;
+    Texture* mainTexture = nullptr;
+    Texture* floatyTexture = nullptr;
 };
 
 struct FireFlicker
@@ -32,11 +74,13 @@ public:
 
     AssetManager(char const* assetFile);
 
-    Background GetRandomBackgroundPaths() const;
+    Texture* GetTexture(eTextureID id) const { return m_textures[id]; }
+    Background const& GetRandomBackground() const;
     FireFlicker GetRandomFireFlicker() const;
-    void GetFireFlickerUVsAtTime(Vec2& uvMins, Vec2& uvMaxs, unsigned int milliSeconds) const;
+    SpriteUVs const& GetFireFlickerUVsAtTime(unsigned int milliSeconds) const;
 
 public:
+    Texture* m_textures[NUM_TEXTURE_IDS] = {};
     std::vector<Background> m_backgrounds;
 
     std::vector<FireFlicker> m_fireTextures;
@@ -49,4 +93,12 @@ public:
     SpriteAnimDefinition* m_singleFinishAnim = nullptr;
     SpriteAnimDefinition* m_multiMonsterAnim = nullptr;
     int m_monsterTailIndex = -1;
+
+    //baked from the animations above, what the note and fire render paths read
+    SpriteAnimUVTable m_fireUVs;
+    SpriteAnimUVTable m_singleMonsterUVs;
+    SpriteAnimUVTable m_singleAttackUVs;
+    SpriteAnimUVTable m_singleFinishUVs;
+    SpriteAnimUVTable m_multiMonsterUVs;
+    SpriteAnimUVTable m_monsterTailUVs;
 };
\ No newline at end of file
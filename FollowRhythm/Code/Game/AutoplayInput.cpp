@@ -0,0 +1,85 @@
+#include "Game/AutoplayInput.hpp"
+#include "Game/NoteTable.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <random>
+
+//////////////////////////////////////////////////////////////////////////
+AutoplayInputSource::AutoplayInputSource(NoteTable const& table, float pressDelayMS, float errorStdDevMS, uint32_t seed)
+{
+    Build(table, pressDelayMS, errorStdDevMS, seed);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void AutoplayInputSource::Build(NoteTable const& table, float pressDelayMS, float errorStdDevMS, uint32_t seed)
+{
+    m_events.clear();
+    m_events.reserve(table.count * 2);
+    m_nextEvent = 0;
+
+    std::mt19937 random(seed);
+    std::normal_distribution<float> error(0.f, errorStdDevMS > 0.f ? errorStdDevMS : 1.f);
+    auto getEdgeMS = [&](float idealMS) {
+        float timeMS = errorStdDevMS > 0.f ? idealMS + error(random) : idealMS;
+        return timeMS <= 0.f ? 0u : (uint32_t)lroundf(timeMS);
+    };
+
+    //index of the release of the last hold on each stick, a chart may start the next hold before it ends
+    size_t lastRelease[2] = { SIZE_MAX, SIZE_MAX };
+    for (uint32_t i = 0; i < table.count; i++) {
+        GameplayInputEvent input;
+        input.isLeft = table.IsLeft(i);
+        if (!table.IsHold(i)) {
+            input.type = GAMEPLAY_INPUT_BUTTON_PRESSED;
+            input.timeMS = getEdgeMS((float)table.startMS[i] + pressDelayMS);
+            m_events.push_back(input);
+            continue;
+        }
+
+        input.type = GAMEPLAY_INPUT_STICK_MOVED;
+        input.yValue = table.isUp[i] ? 1.f : -1.f;
+        input.timeMS = getEdgeMS((float)table.startMS[i]);
+        uint32_t pushMS = input.timeMS;
+        size_t& release = lastRelease[input.isLeft ? 0 : 1];
+        if (release != SIZE_MAX && m_events[release].timeMS > pushMS) {
+            m_events[release].timeMS = pushMS;
+        }
+        m_events.push_back(input);
+
+        input.yValue = 0.f;
+        input.timeMS = getEdgeMS((float)(table.startMS[i] + table.duration[i]));
+        input.timeMS = input.timeMS > pushMS ? input.timeMS : pushMS + 1;
+        release = m_events.size();
+        m_events.push_back(input);
+    }
+
+    //a stick let go and pushed again in the same ms has to release first
+    std::stable_sort(m_events.begin(), m_events.end(), [](GameplayInputEvent const& a, GameplayInputEvent const& b) {
+        if (a.timeMS != b.timeMS) {
+            return a.timeMS < b.timeMS;
+        }
+        bool isReleaseA = a.type == GAMEPLAY_INPUT_STICK_MOVED && a.yValue == 0.f;
+        bool isReleaseB = b.type == GAMEPLAY_INPUT_STICK_MOVED && b.yValue == 0.f;
+        return isReleaseA && !isReleaseB;
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////
+void AutoplayInputSource::SeekTo(uint32_t timeMS)
+{
+    auto iter = std::lower_bound(m_events.begin(), m_events.end(), timeMS, [](GameplayInputEvent const& input, uint32_t targetMS) {
+        return input.timeMS < targetMS;
+    });
+    m_nextEvent = (size_t)(iter - m_events.begin());
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool AutoplayInputSource::PopInput(uint32_t untilMS, GameplayInputEvent& outInput)
+{
+    if (m_nextEvent >= m_events.size() || m_events[m_nextEvent].timeMS > untilMS) {
+        return false;
+    }
+    outInput = m_events[m_nextEvent++];
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Game/SongSimulation.hpp"
+
+struct NoteTable;
+
+//bot player reading the chart: presses singles on time, pushes the stick through every hold
+//timing error is gaussian per edge, 0 gives a perfect run
+class AutoplayInputSource : public GameplayInputSource
+{
+public:
+    AutoplayInputSource() = default;
+    AutoplayInputSource(NoteTable const& table, float pressDelayMS, float errorStdDevMS = 0.f, uint32_t seed = 0);
+
+    void Build(NoteTable const& table, float pressDelayMS, float errorStdDevMS = 0.f, uint32_t seed = 0);
+    void Rewind()                         { m_nextEvent = 0; }
+    void SeekTo(uint32_t timeMS);        //next event is the first one at or after timeMS
+
+    bool PopInput(uint32_t untilMS, GameplayInputEvent& outInput) override;
+
+    size_t GetEventCount() const          { return m_events.size(); }
+
+private:
+    std::vector<GameplayInputEvent> m_events;   //time order
+    size_t m_nextEvent = 0;
+};
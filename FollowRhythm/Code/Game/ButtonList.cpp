@@ -1,11 +1,13 @@
 #include "Game/ButtonList.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/FrameVertexArena.hpp"
+#include "Game/TextLayoutCache.hpp"
 #include "Game/Game.hpp"
+#include "Game/GameAudioSystem.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/Timer.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Input/XboxController.hpp"
 
@@ -39,7 +41,7 @@ void ButtonList::UpdateForNavigationInput(XboxController const& controller)
 void ButtonList::Render(std::vector<Vertex_PCU>& textVerts) const
 {
     //draw background
-    std::vector<Vertex_PCU> bgVerts;
+    std::vector<Vertex_PCU>& bgVerts = g_theFrameVerts->Acquire();
     for(Button const& button : m_buttons){
         Rgba8 color = m_greyColor;
         AABB2 bounds = button.drawBounds;
@@ -51,10 +53,10 @@ void ButtonList::Render(std::vector<Vertex_PCU>& textVerts) const
             bounds.SetDimensions(dim);
             textSize = dim.y*.5f;
         }
-        g_theFont->AddVertsForTextInBox2D(textVerts, bounds, textSize, button.text, m_textColor, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+        g_theTextLayouts->AddVertsForTextInBox2D(textVerts, bounds, textSize, button.text, m_textColor, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
         AppendVertsForAABB2D(bgVerts, bounds, Vec2::ZERO, Vec2::ONE, color);
     }
-    g_theRenderer->BindDiffuseTexture(m_buttonTex);
+    BindTexture(m_buttonTex);
     g_theRenderer->DrawVertexArray(bgVerts);    
 }
 
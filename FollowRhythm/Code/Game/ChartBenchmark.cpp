@@ -0,0 +1,176 @@
+#include "Game/ChartParser.hpp"
+#include "Game/NoteTable.hpp"
+#include "Game/ActiveNoteWindow.hpp"
+#include "Game/MonotonicArena.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/Song.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+static const char* sBenchmarkMusicFolder = "data/music/";
+static const char* sSyntheticChartPath = "data/log/benchmark_chart.csv";
+static const unsigned int sSyntheticLineCount = 1000000;
+static const unsigned int sStressFrameMS = 16;
+
+//////////////////////////////////////////////////////////////////////////
+//the per-line string pipeline Song::LoadNotesFile used before ChartParser
+static void ReadNoteRecordsWithLegacyPath(std::string const& notesFile, std::vector<ChartNoteRecord>& records)
+{
+    Strings lines = FileReadLines(notesFile);
+    for (size_t i = 1; i < lines.size(); i++) {
+        std::string line = lines[i];
+
+        Strings trunks = SplitStringOnDelimiter(line, '\t');
+        if (trunks.size() == 6) {
+            ChartNoteRecord record;
+            record.startMS = GetMilliSecondsFromString(trunks[1]);
+            record.duration = GetMilliSecondsFromString(trunks[2]);
+            record.flags = MakeChartNoteFlags(IsNameLeftNode(trunks[0]), IsNameUpNode(trunks[0]));
+            records.push_back(record);
+        }
+    }
+    SortChartNoteRecords(records);
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool AreRecordsSame(std::vector<ChartNoteRecord> const& a, std::vector<ChartNoteRecord> const& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].startMS != b[i].startMS || a[i].duration != b[i].duration || a[i].flags != b[i].flags) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool WriteSyntheticChart()
+{
+    std::string text = "\xEF\xBB\xBFName\tStart\tDuration\tTime Format\tType\tDescription\n";
+    text.reserve(sSyntheticLineCount * 40);
+    static const char* sNames[] = { "l", "r", "lu", "rd" };
+    for (unsigned int i = 0; i < sSyntheticLineCount; i++) {
+        unsigned int startMS = i * 37;
+        unsigned int duration = (i % 4 >= 2) ? 250 + (i % 7) * 50 : 0;
+        text += Stringf("%s\t%u:%02u.%03u\t%u:%02u.%03u\tdecimal\tCue\t\n", sNames[i % 4],
+            startMS / 60000, (startMS / 1000) % 60, startMS % 1000,
+            duration / 60000, (duration / 1000) % 60, duration % 1000);
+    }
+    return FileWriteToDisk(sSyntheticChartPath, text.data(), text.size());
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void BenchmarkChart(std::string const& notesFile, int repeatCount)
+{
+    std::vector<ChartNoteRecord> legacyRecords;
+    double startSeconds = GetCurrentTimeSeconds();
+    for (int i = 0; i < repeatCount; i++) {
+        legacyRecords.clear();
+        ReadNoteRecordsWithLegacyPath(notesFile, legacyRecords);
+    }
+    double legacyMS = (GetCurrentTimeSeconds() - startSeconds) * 1000.0 / (double)repeatCount;
+
+    std::vector<ChartNoteRecord> streamRecords;
+    std::vector<ChartParseError> errors;
+    startSeconds = GetCurrentTimeSeconds();
+    for (int i = 0; i < repeatCount; i++) {
+        streamRecords.clear();
+        errors.clear();
+        ReadNotesCSVFile(notesFile, streamRecords, errors);
+    }
+    double streamMS = (GetCurrentTimeSeconds() - startSeconds) * 1000.0 / (double)repeatCount;
+
+    Rgba8 color = AreRecordsSame(legacyRecords, streamRecords) ? Rgba8::WHITE : Rgba8::RED;
+    g_theConsole->PrintString(color, Stringf("%s\n    notes: %u  legacy: %.3f ms  stream: %.3f ms  speedup: x%.1f",
+        notesFile.c_str(), (unsigned int)streamRecords.size(), legacyMS, streamMS,
+        streamMS > 0.0 ? legacyMS / streamMS : 0.0));
+}
+
+//////////////////////////////////////////////////////////////////////////
+COMMAND(BenchmarkChartParser, "compare legacy and streaming chart parsing, repeat=10 synthetic=true", eEventFlag::EVENT_GLOBAL)
+{
+    int repeatCount = args.GetValue("repeat", 10);
+    repeatCount = repeatCount < 1 ? 1 : repeatCount;
+    bool runSynthetic = args.GetValue("synthetic", true);
+
+    std::vector<std::string> musicList = FilesFindInDirectory(sBenchmarkMusicFolder, "*.mp3");
+    for (std::string musicPath : musicList) {
+        BenchmarkChart(GetNotesFilePath(GetMusicPathWithoutEXT(musicPath)), repeatCount);
+    }
+
+    if (runSynthetic) {
+        if (WriteSyntheticChart()) {
+            BenchmarkChart(sSyntheticChartPath, 1);
+        }
+        else {
+            g_theConsole->PrintString(Rgba8::RED, Stringf("writing %s failed", sSyntheticChartPath));
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//dense chart with long holds crossing many singles, worst case for out of order retire
+static void MakeStressChartRecords(unsigned int noteCount, std::vector<ChartNoteRecord>& records)
+{
+    records.resize(noteCount);
+    for (unsigned int i = 0; i < noteCount; i++) {
+        ChartNoteRecord& record = records[i];
+        record.startMS = i * 23;
+        record.duration = (i % 50 == 0) ? 4000 + (i % 7) * 500 : 0;
+        record.flags = MakeChartNoteFlags(i % 2 == 0, i % 3 == 0);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+COMMAND(StressNoteWindow, "run a synthetic chart through the active note window, notes=100000", eEventFlag::EVENT_GLOBAL)
+{
+    unsigned int noteCount = (unsigned int)args.GetValue("notes", 100000);
+    std::vector<ChartNoteRecord> records;
+    MakeStressChartRecords(noteCount, records);
+
+    MonotonicArena arena;
+    NoteTable table;
+    table.Build(records.data(), noteCount, arena);
+    ActiveNoteWindow window;
+    window.Init(table, arena);
+
+    std::vector<uint8_t> retired(noteCount, 0);
+    unsigned int retiredCount = 0;
+    unsigned int spawnedCount = 0;
+    size_t maxSlots = 0;
+    bool isValid = true;
+    uint32_t endMS = noteCount == 0 ? 0 : table.renderEndMS[noteCount - 1] + 10000;
+    double startSeconds = GetCurrentTimeSeconds();
+    for (uint32_t elapsedMS = 0; elapsedMS <= endMS; elapsedMS += sStressFrameMS) {
+        for (size_t slot = 0; slot < window.GetSlotCount(); slot++) {
+            uint32_t noteIndex = window.GetNoteInSlot(slot);
+            if (noteIndex != ACTIVE_NOTE_TOMBSTONE && table.renderEndMS[noteIndex] <= elapsedMS) {
+                isValid = isValid && retired[noteIndex] == 0;
+                retired[noteIndex] = 1;
+                retiredCount++;
+                window.RetireSlot(slot);
+            }
+        }
+        window.TrimRetired();
+
+        size_t slotsBefore = window.GetSlotCount();
+        window.SpawnNewNotes(table, elapsedMS);
+        spawnedCount += (unsigned int)(window.GetSlotCount() - slotsBefore);
+        maxSlots = window.GetSlotCount() > maxSlots ? window.GetSlotCount() : maxSlots;
+        isValid = isValid && window.GetSlotCount() <= window.GetCapacity();
+    }
+    double totalMS = (GetCurrentTimeSeconds() - startSeconds) * 1000.0;
+
+    isValid = isValid && window.IsEmpty() && retiredCount == spawnedCount;
+    Rgba8 color = isValid ? Rgba8::WHITE : Rgba8::RED;
+    g_theConsole->PrintString(color, Stringf("notes: %u  spawned: %u  retired: %u  capacity: %u  peak slots: %u  frames: %.3f ms total",
+        noteCount, spawnedCount, retiredCount, window.GetCapacity(), (unsigned int)maxSlots, totalMS));
+    return true;
+}
@@ -0,0 +1,182 @@
+#include "Game/ChartFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool MappedFile::Open(char const* filePath)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = (uint8_t const*)view;
+    m_size = (size_t)fileSize.QuadPart;
+#else
+    int file = open(filePath, O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(file);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = (uint8_t const*)view;
+    m_size = (size_t)fileStat.st_size;
+#endif
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle != nullptr) {
+        CloseHandle((HANDLE)m_mappingHandle);
+    }
+    if (m_fileHandle != nullptr) {
+        CloseHandle((HANDLE)m_fileHandle);
+    }
+#else
+    if (m_data != nullptr) {
+        munmap((void*)m_data, m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint8_t MakeChartNoteFlags(bool isLeft, bool isUp)
+{
+    uint8_t flags = 0;
+    if (isLeft) {
+        flags |= CHART_NOTE_LEFT;
+    }
+    if (isUp) {
+        flags |= CHART_NOTE_UP;
+    }
+    return flags;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SortChartNoteRecords(std::vector<ChartNoteRecord>& records)
+{
+    std::stable_sort(records.begin(), records.end(), [](ChartNoteRecord const& a, ChartNoteRecord const& b) {
+        return a.startMS < b.startMS;
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint64_t HashChartRecords(ChartNoteRecord const* records, uint32_t noteCount)
+{
+    uint64_t hash = 14695981039346656037ull;
+    uint8_t const* bytes = (uint8_t const*)records;
+    size_t byteCount = (size_t)noteCount * sizeof(ChartNoteRecord);
+    for (size_t i = 0; i < byteCount; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ChartNoteRecord const* GetChartRecordsFromMemory(uint8_t const* data, size_t size, uint32_t& outNoteCount)
+{
+    outNoteCount = 0;
+    if (data == nullptr || size < sizeof(ChartFileHeader)) {
+        return nullptr;
+    }
+
+    ChartFileHeader header;
+    memcpy(&header, data, sizeof(ChartFileHeader));
+    if (header.magic != CHART_FILE_MAGIC || header.version != CHART_FILE_VERSION ||
+        header.recordSize != sizeof(ChartNoteRecord)) {
+        return nullptr;
+    }
+
+    size_t expectedSize = sizeof(ChartFileHeader) + (size_t)header.noteCount * sizeof(ChartNoteRecord);
+    if (size < expectedSize) {
+        return nullptr;
+    }
+
+    outNoteCount = header.noteCount;
+    return (ChartNoteRecord const*)(data + sizeof(ChartFileHeader));
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool WriteChartFile(std::string const& chartFilePath, std::vector<ChartNoteRecord> const& sortedRecords)
+{
+    ChartFileHeader header;
+    header.recordSize = (uint16_t)sizeof(ChartNoteRecord);
+    header.noteCount = (uint32_t)sortedRecords.size();
+
+    std::ofstream file(chartFilePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write((char const*)&header, sizeof(ChartFileHeader));
+    if (!sortedRecords.empty()) {
+        file.write((char const*)sortedRecords.data(), (std::streamsize)(sortedRecords.size() * sizeof(ChartNoteRecord)));
+    }
+    return file.good();
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//compiled chart: header followed by fixed-width note records, sorted by start time
+constexpr uint32_t CHART_FILE_MAGIC = 0x48435246;   //"FRCH" little endian
+constexpr uint16_t CHART_FILE_VERSION = 1;
+
+enum eChartNoteFlag : uint8_t
+{
+    CHART_NOTE_LEFT = 1 << 0,
+    CHART_NOTE_UP   = 1 << 1,
+};
+
+struct ChartFileHeader
+{
+    uint32_t magic = CHART_FILE_MAGIC;
+    uint16_t version = CHART_FILE_VERSION;
+    uint16_t recordSize = 0;
+    uint32_t noteCount = 0;
+    uint32_t reserved = 0;
+};
+
+struct ChartNoteRecord
+{
+    uint32_t startMS = 0;
+    uint32_t duration = 0;  //0 for single notes
+    uint8_t  flags = 0;     //eChartNoteFlag
+    uint8_t  padding[3] = {0,0,0};
+
+    bool IsLeft() const { return (flags & CHART_NOTE_LEFT) != 0; }
+    bool IsUp() const   { return (flags & CHART_NOTE_UP) != 0; }
+};
+
+static_assert(sizeof(ChartFileHeader) == 16, "chart header layout changed, bump CHART_FILE_VERSION");
+static_assert(sizeof(ChartNoteRecord) == 12, "chart record layout changed, bump CHART_FILE_VERSION");
+
+//read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool Open(char const* filePath);
+    void Close();
+
+    bool           IsOpen() const  { return m_data != nullptr; }
+    uint8_t const* GetData() const { return m_data; }
+    size_t         GetSize() const { return m_size; }
+
+private:
+    uint8_t const* m_data = nullptr;
+    size_t m_size = 0;
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+};
+
+uint8_t MakeChartNoteFlags(bool isLeft, bool isUp);
+void    SortChartNoteRecords(std::vector<ChartNoteRecord>& records);
+uint64_t HashChartRecords(ChartNoteRecord const* records, uint32_t noteCount);  //FNV-1a over the record bytes
+
+//returns record view into data, nullptr if header is invalid or truncated
+ChartNoteRecord const* GetChartRecordsFromMemory(uint8_t const* data, size_t size, uint32_t& outNoteCount);
+bool WriteChartFile(std::string const& chartFilePath, std::vector<ChartNoteRecord> const& sortedRecords);
@@ -0,0 +1,191 @@
+#include "Game/ChartParser.hpp"
+
+static const char sUTF8BOM[] = "\xEF\xBB\xBF";
+
+//////////////////////////////////////////////////////////////////////////
+static bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+//////////////////////////////////////////////////////////////////////////
+static size_t ParseDigits(std::string_view text, size_t pos, uint32_t& outValue)
+{
+    size_t start = pos;
+    uint32_t value = 0;
+    while (pos < text.size() && IsDigit(text[pos])) {
+        value = value * 10 + (uint32_t)(text[pos] - '0');
+        pos++;
+    }
+    outValue = value;
+    return pos - start;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static size_t SplitLineIntoFields(std::string_view line, std::string_view* fields, size_t maxFields)
+{
+    size_t fieldCount = 0;
+    size_t fieldStart = 0;
+    for (size_t i = 0; i <= line.size(); i++) {
+        if (i == line.size() || line[i] == '\t') {
+            if (fieldCount < maxFields) {
+                fields[fieldCount] = line.substr(fieldStart, i - fieldStart);
+            }
+            fieldCount++;
+            fieldStart = i + 1;
+        }
+    }
+    return fieldCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void AddParseError(std::vector<ChartParseError>& errors, uint32_t lineNumber, std::string const& message)
+{
+    ChartParseError error;
+    error.lineNumber = lineNumber;
+    error.message = message;
+    errors.push_back(error);
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ParseTimeTextToMS(std::string_view timeText, uint32_t& outMS)
+{
+    size_t pos = 0;
+    uint32_t totalSeconds = 0;
+    int groupCount = 0;
+    while (true) {
+        uint32_t value = 0;
+        size_t digitCount = ParseDigits(timeText, pos, value);
+        if (digitCount == 0) {
+            return false;
+        }
+        if (groupCount > 0 && value >= 60) {
+            return false;
+        }
+        totalSeconds = totalSeconds * 60 + value;
+        groupCount++;
+        pos += digitCount;
+
+        if (pos < timeText.size() && timeText[pos] == ':') {
+            if (groupCount == 3) {
+                return false;
+            }
+            pos++;
+            continue;
+        }
+        break;
+    }
+
+    uint32_t milliSeconds = 0;
+    if (pos < timeText.size() && timeText[pos] == '.') {
+        pos++;
+        uint32_t scale = 100;
+        size_t fractionStart = pos;
+        while (pos < timeText.size() && IsDigit(timeText[pos])) {
+            milliSeconds += (uint32_t)(timeText[pos] - '0') * scale;  //digits past ms are dropped
+            scale /= 10;
+            pos++;
+        }
+        if (pos == fractionStart) {
+            return false;
+        }
+    }
+
+    if (pos != timeText.size()) {
+        return false;
+    }
+
+    outMS = totalSeconds * 1000 + milliSeconds;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ParseNotesCSV(char const* data, size_t size, std::vector<ChartNoteRecord>& outRecords,
+    std::vector<ChartParseError>& outErrors)
+{
+    std::string_view text(data, size);
+    if (text.substr(0, 3) == std::string_view(sUTF8BOM, 3)) {
+        text.remove_prefix(3);
+    }
+
+    //one record per line at most, header included
+    size_t lineEstimate = 0;
+    for (char c : text) {
+        lineEstimate += (c == '\n') ? 1 : 0;
+    }
+    outRecords.reserve(outRecords.size() + lineEstimate + 1);
+
+    size_t firstRecord = outRecords.size();
+    std::string_view fields[CHART_CSV_COLUMN_COUNT];
+    uint32_t lineNumber = 0;
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        lineNumber++;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (lineNumber == 1 || line.empty()) {  //header
+            continue;
+        }
+
+        size_t fieldCount = SplitLineIntoFields(line, fields, CHART_CSV_COLUMN_COUNT);
+        if (fieldCount != CHART_CSV_COLUMN_COUNT) {
+            AddParseError(outErrors, lineNumber, "expected 6 columns, found " + std::to_string(fieldCount));
+            continue;
+        }
+
+        std::string_view name = fields[0];
+        if (name.empty()) {
+            AddParseError(outErrors, lineNumber, "empty note name");
+            continue;
+        }
+        char lane = name[0];
+        if (lane != 'L' && lane != 'l' && lane != 'R' && lane != 'r') {
+            AddParseError(outErrors, lineNumber, "note name should start with L or R");
+            continue;
+        }
+
+        ChartNoteRecord record;
+        if (!ParseTimeTextToMS(fields[1], record.startMS)) {
+            AddParseError(outErrors, lineNumber, "malformed start time");
+            continue;
+        }
+        if (!ParseTimeTextToMS(fields[2], record.duration)) {
+            AddParseError(outErrors, lineNumber, "malformed duration");
+            continue;
+        }
+
+        bool isLeft = (lane == 'L' || lane == 'l');
+        bool isUp = name.size() > 1 && (name[1] == 'U' || name[1] == 'u');
+        record.flags = MakeChartNoteFlags(isLeft, isUp);
+        outRecords.push_back(record);
+    }
+
+    //Audition exports in marker order, which is usually but not always time order
+    for (size_t i = firstRecord + 1; i < outRecords.size(); i++) {
+        if (outRecords[i].startMS < outRecords[i - 1].startMS) {
+            SortChartNoteRecords(outRecords);
+            break;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ReadNotesCSVFile(std::string const& notesFilePath, std::vector<ChartNoteRecord>& outRecords,
+    std::vector<ChartParseError>& outErrors)
+{
+    MappedFile file;
+    if (!file.Open(notesFilePath.c_str())) {
+        return false;
+    }
+
+    ParseNotesCSV((char const*)file.GetData(), file.GetSize(), outRecords, outErrors);
+    return true;
+}
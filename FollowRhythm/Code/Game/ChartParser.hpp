@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Game/ChartFile.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+//Adobe Audition marker export: Name, Start, Duration, Time Format, Type, Description (tab separated)
+constexpr size_t CHART_CSV_COLUMN_COUNT = 6;
+
+struct ChartParseError
+{
+    uint32_t lineNumber = 0;    //1-based, header is line 1
+    std::string message;
+};
+
+//"m:ss.mmm", also accepts "h:mm:ss.mmm" and a missing fraction
+bool ParseTimeTextToMS(std::string_view timeText, uint32_t& outMS);
+
+//single pass over the whole buffer, no per-line allocation; records come out sorted by start time
+void ParseNotesCSV(char const* data, size_t size, std::vector<ChartNoteRecord>& outRecords,
+    std::vector<ChartParseError>& outErrors);
+bool ReadNotesCSVFile(std::string const& notesFilePath, std::vector<ChartNoteRecord>& outRecords,
+    std::vector<ChartParseError>& outErrors);
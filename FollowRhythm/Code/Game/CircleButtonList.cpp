@@ -1,5 +1,7 @@
 #include "Game/CircleButtonList.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/FrameVertexArena.hpp"
+#include "Game/TextLayoutCache.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
@@ -27,7 +29,7 @@ static void AppendAABB2ToVertsArrayWithColor(std::vector<Vertex_PCU>& verts, AAB
 //////////////////////////////////////////////////////////////////////////
 void CircleButtonList::Render(std::vector<Vertex_PCU>& textVerts) const
 {
-    std::vector<Vertex_PCU> bgVerts;
+    std::vector<Vertex_PCU>& bgVerts = g_theFrameVerts->Acquire();
     Vec2 generalDim = m_generalDrawBounds.GetDimensions();
     float lineNum = (float)m_showLines;
     float singleHeight = generalDim.y/(lineNum+2.f);
@@ -45,7 +47,7 @@ void CircleButtonList::Render(std::vector<Vertex_PCU>& textVerts) const
 
     //bottom
     unsigned int bottomIdx = m_selectedIndex==buttonNum-1? 0: m_selectedIndex+1;
-    g_theFont->AddVertsForTextInBox2D(textVerts, singleBounds, textHeight, m_buttons[bottomIdx].text,
+    g_theTextLayouts->AddVertsForTextInBox2D(textVerts, singleBounds, textHeight, m_buttons[bottomIdx].text,
         Rgba8::WHITE, FONT_DEFAULT_ASPECT, m_textAlignment, .05f, FONT_DEFAULT_KERNING);
     AppendAABB2ToVertsArrayWithColor(bgVerts, singleBounds, greyWhite, transWhite, transWhite, greyWhite);
 
@@ -53,7 +55,7 @@ void CircleButtonList::Render(std::vector<Vertex_PCU>& textVerts) const
     singleBounds.Translate(deltaTrans+Vec2(0.f, singleHeight*.5f));
     AABB2 highlightBounds = singleBounds;
     highlightBounds.SetDimensions(1.8f*singleDim);
-    g_theFont->AddVertsForTextInBox2D(textVerts, m_generalDrawBounds, textHeight*2.f, m_buttons[m_selectedIndex].text,
+    g_theTextLayouts->AddVertsForTextInBox2D(textVerts, m_generalDrawBounds, textHeight*2.f, m_buttons[m_selectedIndex].text,
         Rgba8::WHITE, FONT_DEFAULT_ASPECT, Vec2(.1f, .5f), .05f, FONT_DEFAULT_KERNING);
     Rgba8 transHighlight = m_highlightColor;
     transHighlight.a = 0;
@@ -62,11 +64,11 @@ void CircleButtonList::Render(std::vector<Vertex_PCU>& textVerts) const
     //top
     unsigned int topIdx = m_selectedIndex==0?buttonNum-1:m_selectedIndex-1;
     singleBounds.Translate(deltaTrans+Vec2(0.f,singleHeight*.5f));
-    g_theFont->AddVertsForTextInBox2D(textVerts, singleBounds, textHeight, m_buttons[topIdx].text,
+    g_theTextLayouts->AddVertsForTextInBox2D(textVerts, singleBounds, textHeight, m_buttons[topIdx].text,
         Rgba8::WHITE, FONT_DEFAULT_ASPECT, m_textAlignment, .05f, FONT_DEFAULT_KERNING);
     AppendAABB2ToVertsArrayWithColor(bgVerts, singleBounds, greyWhite, transWhite, transWhite, greyWhite);
 
     //draw
-    g_theRenderer->BindDiffuseTexture(m_buttonTex);
+    BindTexture(m_buttonTex);
     g_theRenderer->DrawVertexArray(bgVerts);
 }
@@ -1,6 +1,7 @@
 #include "Game/Effects.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/AssetManager.hpp"
 #include "Engine/Renderer/ParticleSystem2D.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/Emitter2D.hpp"
@@ -36,7 +37,7 @@ static Emitter2D* PlayParticleEffect(Vec2 const& pos, float dirDegrees, Rgba8 co
 void InitEffects()
 {
     ParticleSystem2D::gParticleSystem2D = new ParticleSystem2D(g_theRenderer);
-    sParticleTex = g_theRenderer->CreateOrGetTextureFromFile("data/images/particle.png");
+    sParticleTex = AssetManager::gAssetManager->GetTexture(TEXTURE_PARTICLE);
 }
 
 //////////////////////////////////////////////////////////////////////////
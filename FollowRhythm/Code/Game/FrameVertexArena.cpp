@@ -0,0 +1,56 @@
+#include "Game/FrameVertexArena.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+FrameVertexArena::~FrameVertexArena()
+{
+    for (FrameBuffer& buffer : m_buffers) {
+        delete buffer.verts;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+std::vector<Vertex_PCU>& FrameVertexArena::Acquire()
+{
+    if (m_nextBuffer >= m_buffers.size()) {
+        if (m_buffers.size() == m_buffers.capacity()) {
+            m_growthCount++;
+        }
+        FrameBuffer buffer;
+        buffer.verts = new std::vector<Vertex_PCU>();
+        m_buffers.push_back(buffer);
+        m_growthCount++;
+    }
+
+    std::vector<Vertex_PCU>& verts = *m_buffers[m_nextBuffer++].verts;
+    verts.clear();
+    return verts;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void FrameVertexArena::BeginFrame()
+{
+    //a buffer that outgrew its capacity reallocated at least once last frame
+    for (size_t i = 0; i < m_nextBuffer; i++) {
+        FrameBuffer& buffer = m_buffers[i];
+        size_t capacity = buffer.verts->capacity();
+        if (capacity > buffer.capacity) {
+            m_growthCount++;
+            buffer.capacity = capacity;
+        }
+    }
+
+    m_lastFrameGrowthCount = m_growthCount;
+    m_totalGrowthCount += m_growthCount;
+    m_growthCount = 0;
+    m_nextBuffer = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+size_t FrameVertexArena::GetReservedVertexCount() const
+{
+    size_t count = 0;
+    for (FrameBuffer const& buffer : m_buffers) {
+        count += buffer.verts->capacity();
+    }
+    return count;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Engine/Core/Vertex_PCU.hpp"
+
+//vertex buffers that only live for one frame, handed out in order and all taken back in App::BeginFrame
+//buffers keep their capacity, so once the biggest frame has been drawn nothing is allocated for vertices again
+class FrameVertexArena
+{
+public:
+    FrameVertexArena() = default;
+    FrameVertexArena(FrameVertexArena const&) = delete;
+    FrameVertexArena& operator=(FrameVertexArena const&) = delete;
+    ~FrameVertexArena();
+
+    std::vector<Vertex_PCU>& Acquire();     //empty, valid until the next BeginFrame
+    void BeginFrame();
+
+    size_t   GetBufferCount() const         { return m_buffers.size(); }
+    size_t   GetReservedVertexCount() const;
+    uint32_t GetLastFrameGrowthCount() const { return m_lastFrameGrowthCount; }  //0 in a steady state
+    uint32_t GetTotalGrowthCount() const    { return m_totalGrowthCount; }
+
+private:
+    struct FrameBuffer
+    {
+        std::vector<Vertex_PCU>* verts = nullptr;  //heap owned so references survive the pool growing
+        size_t capacity = 0;                        //as of the last BeginFrame
+    };
+
+    std::vector<FrameBuffer> m_buffers;
+    size_t m_nextBuffer = 0;
+    uint32_t m_growthCount = 0;             //this frame so far: new buffers and the pool itself
+    uint32_t m_lastFrameGrowthCount = 0;
+    uint32_t m_totalGrowthCount = 0;
+};
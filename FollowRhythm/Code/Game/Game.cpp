@@ -1,12 +1,15 @@
 #include "Game/Game.hpp"
 #include "Game/App.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/FrameVertexArena.hpp"
 #include "Game/ButtonList.hpp"
 #include "Game/Song.hpp"
 #include "Game/SongManager.hpp"
 #include "Game/CircleButtonList.hpp"
 #include "Game/AssetManager.hpp"
 #include "Game/Effects.hpp"
+#include "Game/TextLayoutCache.hpp"
+#include "Game/GameAudioSystem.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
@@ -23,7 +26,6 @@
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/FileUtils.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
 static SoundPlaybackID sAttractPlayID;
@@ -62,7 +64,7 @@ enum sSettingsItem
 COMMAND(UpdateBackground, "randomly update menu background", eEventFlag::EVENT_GAME)
 {
 	UNUSED(args);
-	sMenuBackground = AssetManager::gAssetManager->GetRandomBackgroundPaths();
+	sMenuBackground = AssetManager::gAssetManager->GetRandomBackground();
 	return true;
 }
 
@@ -179,7 +181,7 @@ static void InitMainMenuButtons(AABB2 const& bounds)
     singleBound.Translate(singleTrans);
 	sMainMenuButtons.m_buttons.push_back(Button("Quit", false, singleBound));
 
-	sMainMenuButtons.m_buttonTex=g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/6-new.png");
+	sMainMenuButtons.m_buttonTex=AssetManager::gAssetManager->GetTexture(TEXTURE_BUTTON);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -187,7 +189,7 @@ static void InitConfirmButton(AABB2 const& bounds)
 {
 	sConfirmButtons.m_buttons.push_back(Button("Back", true, bounds));
 
-	sConfirmButtons.m_buttonTex = g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/6-new.png");
+	sConfirmButtons.m_buttonTex = AssetManager::gAssetManager->GetTexture(TEXTURE_BUTTON);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -207,7 +209,7 @@ static void InitSettingsMenuButtons(AABB2 const& bounds)
     singleBound.Translate(singleTrans);
     sSettingsButtons.m_buttons.push_back(Button("Back", false, singleBound));
 
-	sSettingsButtons.m_buttonTex = g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/6-new.png");
+	sSettingsButtons.m_buttonTex = AssetManager::gAssetManager->GetTexture(TEXTURE_BUTTON);
 
 	UpdateMenuForSFXVolume();
 	UpdateMenuForMusicVolume();
@@ -229,6 +231,7 @@ void Game::StartUp()
 	g_theRenderer->SetupParentClock(m_gameClock);
 
 	g_theFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/InnerSpeaker");
+	g_theTextLayouts = new TextLayoutCache(g_theFont);
 	m_RNG = new RandomNumberGenerator();
 	m_worldCamera = new Camera();
 	m_uiCamera = new Camera();
@@ -255,6 +258,8 @@ void Game::ShutDown()
     delete m_worldCamera;
 	delete m_uiCamera;
     delete m_RNG;
+	delete g_theTextLayouts;
+	g_theTextLayouts = nullptr;
 
 }
 
@@ -284,6 +289,7 @@ void Game::Render() const
     RenderForUI();
 
 	DebugRenderWorldToCamera(m_worldCamera);
+	g_theTextLayouts->EndFrame();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -308,18 +314,11 @@ void Game::LoadAndInitialize()
     //init songs   
     std::string assetPath = g_gameConfigBlackboard->GetValue("assetsReading", "data/assets.xml");
     AssetManager::gAssetManager = new AssetManager(assetPath.c_str());
-    sMenuBackground = AssetManager::gAssetManager->GetRandomBackgroundPaths();
+    sMenuBackground = AssetManager::gAssetManager->GetRandomBackground();
 	InitButtonAssets();
 
 	m_songManager = new SongManager(this, "data/music/");
 
-	//g_theRenderer->CreateOrGetTextureFromFile("data/images/base.png");
-	g_theRenderer->CreateOrGetTextureFromFile("data/images/gamepad.png");
-	g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/progress.png");
-	g_theRenderer->CreateOrGetTextureFromFile("data/images/minus.png");
-	g_theRenderer->CreateOrGetTextureFromFile("data/images/plus.png");
-	g_theRenderer->CreateOrGetTextureFromFile("data/images/base.png");
-
     //config
     InitConfigData();
 
@@ -376,7 +375,7 @@ void Game::InitMusicSelectMenu()
 	sMusicSelectButtons.m_greyColor = Rgba8(100,100,10);
 	sMusicSelectButtons.m_highlightColor = Rgba8::WHITE;
 
-	sMusicSelectButtons.m_buttonTex = g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/7.png");
+	sMusicSelectButtons.m_buttonTex = AssetManager::gAssetManager->GetTexture(TEXTURE_MUSIC_BUTTON);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -432,7 +431,11 @@ void Game::UpdateForInput()
 		case GAME_MAIN_MENU:		{
 			sMainMenuItem curItem = (sMainMenuItem)sMainMenuButtons.m_selectedIndex;
 			switch (curItem) {
-				case MAIN_MENU_START:		m_state = GAME_MUSIC_SELECT; break;
+				case MAIN_MENU_START:		{
+					m_state = GAME_MUSIC_SELECT;
+					m_songManager->SelectSong(sMusicSelectButtons.m_selectedIndex);
+					break;
+				}
 				case MAIN_MENU_TUTORIAL:	m_state = GAME_TUTORIAL; break;
 				case MAIN_MENU_SETTINGS:	m_state = GAME_SETTINGS; break;
 				case MAIN_MENU_CREDITS:		m_state = GAME_CREDITS; break;
@@ -553,7 +556,11 @@ void Game::UpdateForInput()
 		}
 	}
 	else if (m_state == GAME_MUSIC_SELECT) {
+		unsigned int prevSelected = sMusicSelectButtons.m_selectedIndex;
 		sMusicSelectButtons.UpdateForNavigationInput(controller);
+		if (sMusicSelectButtons.m_selectedIndex != prevSelected) {
+			m_songManager->SelectSong(sMusicSelectButtons.m_selectedIndex);
+		}
 	}
 }
 
@@ -582,29 +589,29 @@ void Game::RenderForUI() const
 	Vec2 uiDim = uiBound.GetDimensions();
 
 	//TODO
-	std::vector<Vertex_PCU> textVerts;
+	std::vector<Vertex_PCU>& textVerts = g_theFrameVerts->Acquire();
 	if (m_isLoading) {
-		g_theFont->AddVertsForTextInBox2D(textVerts, uiBound,uiDim.y*.1f, "Loading...");
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, uiBound,uiDim.y*.1f, "Loading...");
 	}
 	else if(m_state==GAME_ATTRACT){
-        g_theRenderer->BindDiffuseTexture(sMenuBackground.mainBG.c_str());
+        BindTexture(sMenuBackground.mainTexture);
         g_theRenderer->DrawAABB2D(uiBound,sMenuBGTint);
-		g_theFont->AddVertsForTextInBox2D(textVerts, uiBound, uiDim.y*.1f, "Follow Rhythm", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
-		g_theFont->AddVertsForTextInBox2D(textVerts, uiBound, uiDim.y*.02f, "[A] to start, [B] to quit", Rgba8(200,200,200), FONT_DEFAULT_ASPECT, Vec2(.5f,.2f), .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, uiBound, uiDim.y*.1f, "Follow Rhythm", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, uiBound, uiDim.y*.02f, "[A] to start, [B] to quit", Rgba8(200,200,200), FONT_DEFAULT_ASPECT, Vec2(.5f,.2f), .05f, FONT_DEFAULT_KERNING);
 	}
 	else if (m_state == GAME_MAIN_MENU) {
-		g_theRenderer->BindDiffuseTexture(sMenuBackground.mainBG.c_str());
+		BindTexture(sMenuBackground.mainTexture);
 		g_theRenderer->DrawAABB2D(uiBound, sMenuBGTint);
 		AABB2 titleBound = uiBound.GetBoxAtTop(.334f);
-		g_theFont->AddVertsForTextInBox2D(textVerts, titleBound, uiDim.y*.1f, "Follow Rhythm", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, titleBound, uiDim.y*.1f, "Follow Rhythm", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
 		sMainMenuButtons.Render(textVerts);
 	}
 	else if (m_state == GAME_MUSIC_SELECT) {
-        g_theRenderer->BindDiffuseTexture(sMenuBackground.mainBG.c_str());
+        BindTexture(sMenuBackground.mainTexture);
         g_theRenderer->DrawAABB2D(uiBound, sMenuBGTint);
 
-		g_theFont->AddVertsForTextInBox2D(textVerts, uiBound.GetBoxAtTop(.2f), uiDim.y*.08f, "Music Select", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
-		g_theFont->AddVertsForTextInBox2D(textVerts, uiBound.GetBoxAtBottom(.25f), uiDim.y*.02f, "[A] to select   [B] to quit", Rgba8(200,200,200),FONT_DEFAULT_ASPECT,Vec2(.1f, .5f), .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, uiBound.GetBoxAtTop(.2f), uiDim.y*.08f, "Music Select", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, uiBound.GetBoxAtBottom(.25f), uiDim.y*.02f, "[A] to select   [B] to quit", Rgba8(200,200,200),FONT_DEFAULT_ASPECT,Vec2(.1f, .5f), .05f, FONT_DEFAULT_KERNING);
 		sMusicSelectButtons.Render(textVerts);
 
 		//music info render
@@ -617,27 +624,27 @@ void Game::RenderForUI() const
 		float imageLength = imageDim.x>imageDim.y?imageDim.y:imageDim.x;
 		imageBounds.SetDimensions(Vec2(imageLength, imageLength));
 		unsigned int selectedIndex = sMusicSelectButtons.m_selectedIndex;
-		g_theRenderer->BindDiffuseTexture(m_songManager->GetSelectedSongImage(selectedIndex));
+		BindTexture(m_songManager->GetSelectedSongImage(selectedIndex));
 		g_theRenderer->DrawAABB2D(imageBounds);
 
 		AABB2 textBounds = InfoBounds.GetBoxAtBottom(.4f);
 		textBounds.ChopBoxOffLeft(.24f);
-		g_theFont->AddVertsForTextInBox2D(textVerts, textBounds, uiDim.y*.026f, 
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, textBounds, uiDim.y*.026f, 
 			m_songManager->GetSelectedSongInfo(selectedIndex), Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTER_LEFT, .05f, FONT_DEFAULT_KERNING);
 
 		if (sSongInvalidTimer.IsRunning() && !sSongInvalidTimer.HasElapsed()) {
             AABB2 popOut = uiBound;
             popOut.SetDimensions(.3f * uiDim);
-            g_theFont->AddVertsForTextInBox2D(textVerts, popOut, uiDim.y * .02f, "Song Invalid!", Rgba8::BLACK, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
-            g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+            g_theTextLayouts->AddVertsForTextInBox2D(textVerts, popOut, uiDim.y * .02f, "Song Invalid!", Rgba8::BLACK, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+            BindTexture(nullptr);
             g_theRenderer->DrawAABB2D(popOut, Rgba8(255, 255, 255, 150));
 		}
 	}
 	else if (m_state == GAME_SETTINGS || m_state==GAME_SETTINGS_CALIBRATE) {
-        g_theRenderer->BindDiffuseTexture(sMenuBackground.mainBG.c_str());
+        BindTexture(sMenuBackground.mainTexture);
         g_theRenderer->DrawAABB2D(uiBound, sMenuBGTint);
 		AABB2 titleBound = uiBound.GetBoxAtTop(.2f);
-		g_theFont->AddVertsForTextInBox2D(textVerts, titleBound, uiDim.y*.08f, "Settings", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, titleBound, uiDim.y*.08f, "Settings", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
 
 		sSettingsItem curItem = (sSettingsItem)sSettingsButtons.m_selectedIndex;
 		if (curItem == SETTINGS_MUSIC_VOL || curItem == SETTINGS_SFX_VOL) {
@@ -648,22 +655,22 @@ void Game::RenderForUI() const
 			AABB2 leftBounds(uiBound.mins.x, buttonBounds.mins.y, buttonBounds.mins.x, buttonBounds.maxs.y);
 			AABB2 leftIconBound = leftBounds.ChopBoxOffRight(0.f, buttonDim.y);
 			leftIconBound.SetDimensions(.8f*leftIconBound.GetDimensions());
-			g_theRenderer->BindDiffuseTexture("data/images/minus.png");
+			BindTexture(AssetManager::gAssetManager->GetTexture(TEXTURE_MINUS));
 			g_theRenderer->DrawAABB2D(leftIconBound);
-			g_theFont->AddVertsForTextInBox2D(textVerts, leftBounds,buttonDim.y*.6f, "LB", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTER_RIGHT, .05f, FONT_DEFAULT_KERNING);
+			g_theTextLayouts->AddVertsForTextInBox2D(textVerts, leftBounds,buttonDim.y*.6f, "LB", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTER_RIGHT, .05f, FONT_DEFAULT_KERNING);
 
 			AABB2 rightBounds(buttonBounds.maxs.x, buttonBounds.mins.y, uiBound.maxs.x, buttonBounds.maxs.y);
 			AABB2 rightIconBound = rightBounds.ChopBoxOffLeft(0.f, buttonDim.y);
 			rightIconBound.SetDimensions(.8f*rightIconBound.GetDimensions());
-			g_theRenderer->BindDiffuseTexture("data/images/plus.png");
+			BindTexture(AssetManager::gAssetManager->GetTexture(TEXTURE_PLUS));
 			g_theRenderer->DrawAABB2D(rightIconBound);
-			g_theFont->AddVertsForTextInBox2D(textVerts, rightBounds, buttonDim.y*.6f, "RB", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTER_LEFT, .05f, FONT_DEFAULT_KERNING);
+			g_theTextLayouts->AddVertsForTextInBox2D(textVerts, rightBounds, buttonDim.y*.6f, "RB", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTER_LEFT, .05f, FONT_DEFAULT_KERNING);
 		}
 
 		sSettingsButtons.Render(textVerts);
 		
 		if (m_state == GAME_SETTINGS_CALIBRATE) {
-			g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+			BindTexture(nullptr);
 			g_theRenderer->DrawAABB2D(uiBound, Rgba8(0,0,0,100));
 
 			AABB2 textBound = uiBound.GetBoxAtTop(.45f);
@@ -674,23 +681,23 @@ void Game::RenderForUI() const
 				gNoteDelayDelta, Song::GetAverageCalibrationDeltaTime());
 			calibText += "[LB] Hit Note\n[A] Confirm Calibration\n[B] Cancel Calibration";
 			float textHeight = textBound.GetDimensions().y*.1f;
-			g_theFont->AddVertsForTextInBox2D(textVerts, textBound, textHeight, calibText, Rgba8::WHITE, FONT_DEFAULT_ASPECT,ALIGN_CENTERED, .1f, FONT_DEFAULT_KERNING);
+			g_theTextLayouts->AddVertsForTextInBox2D(textVerts, textBound, textHeight, calibText, Rgba8::WHITE, FONT_DEFAULT_ASPECT,ALIGN_CENTERED, .1f, FONT_DEFAULT_KERNING);
 		}
 
 		if (sClearHistoryTimer.IsRunning() && !sClearHistoryTimer.HasElapsed()) {
             AABB2 popOut = uiBound;
 			popOut.SetDimensions(.3f * uiDim);
-            g_theFont->AddVertsForTextInBox2D(textVerts, popOut, uiDim.y * .02f, "History Cleared!", Rgba8::BLACK, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
-			g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+            g_theTextLayouts->AddVertsForTextInBox2D(textVerts, popOut, uiDim.y * .02f, "History Cleared!", Rgba8::BLACK, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+			BindTexture(nullptr);
             g_theRenderer->DrawAABB2D(popOut, Rgba8(255, 255, 255, 150));
 		}
 	}
 	else if (m_state == GAME_TUTORIAL) {
-        g_theRenderer->BindDiffuseTexture(sMenuBackground.mainBG.c_str());
+        BindTexture(sMenuBackground.mainTexture);
         g_theRenderer->DrawAABB2D(uiBound, sMenuBGTint);
 
 		AABB2 titleBound = uiBound.GetBoxAtTop(.2f);
-		g_theFont->AddVertsForTextInBox2D(textVerts, titleBound, uiDim.y*.08f, "Controls", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, titleBound, uiDim.y*.08f, "Controls", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
 		sConfirmButtons.Render(textVerts);
 
 		AABB2 tutBound = uiBound.GetBoxAtBottom(.75f);
@@ -701,28 +708,28 @@ void Game::RenderForUI() const
 		AABB2 gamepadBound = tutBound;
 		Vec2 dim = tutBound.GetDimensions();
 		gamepadBound.SetDimensions(Vec2(dim.y, dim.y));
-		g_theRenderer->BindDiffuseTexture("data/images/gamepad.png");
+		BindTexture(AssetManager::gAssetManager->GetTexture(TEXTURE_GAMEPAD));
 		g_theRenderer->DrawAABB2D(gamepadBound);
 
 		Vec2 textDim((dim.x-dim.y), dim.y);
 		Vec2 topLeft( gamepadBound.mins.x, gamepadBound.maxs.y);
 		AABB2 leftTextBound(topLeft-textDim, topLeft);
 		float textSize = textDim.y * .05f;
-		g_theFont->AddVertsForTextInBox2D(textVerts, leftTextBound, textSize, 
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, leftTextBound, textSize, 
 			"Quit to previous [B]\n\n[LB]\nHit single note from left \n\n[Left Stick]\nMove up/down \nfor consecutive note \n from left ",
 			Rgba8::WHITE, FONT_DEFAULT_ASPECT, Vec2(1.f, .5f), .1f, FONT_DEFAULT_KERNING);
 
 		Vec2 bottomRight(gamepadBound.maxs.x, gamepadBound.mins.y);
 		AABB2 rightTextBound(bottomRight, bottomRight+textDim);
-        g_theFont->AddVertsForTextInBox2D(textVerts, rightTextBound, textSize,
+        g_theTextLayouts->AddVertsForTextInBox2D(textVerts, rightTextBound, textSize,
             "[A] Confirm Selection\n\n[RB]\n Hit single note from right\n\n[Right Stick]\n Move up/down\n for consecutive note\n from right",
             Rgba8::WHITE, FONT_DEFAULT_ASPECT, Vec2(0.f, .5f), .1f,FONT_DEFAULT_KERNING);
 	}
 	else if (m_state == GAME_CREDITS) {
-		g_theRenderer->BindDiffuseTexture(sMenuBackground.mainBG.c_str());
+		BindTexture(sMenuBackground.mainTexture);
 		g_theRenderer->DrawAABB2D(uiBound, sMenuBGTint);
 
-		g_theFont->AddVertsForTextInBox2D(textVerts, uiBound.GetBoxAtTop(.15f), uiDim.y*.06f, "Credits", 
+		g_theTextLayouts->AddVertsForTextInBox2D(textVerts, uiBound.GetBoxAtTop(.15f), uiDim.y*.06f, "Credits", 
 			Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
 		sConfirmButtons.Render(textVerts);
 
@@ -749,7 +756,7 @@ Calibration Song:     https://freemusicarchive.org/music/Blue_Dot_Sessions/Radio
 Button Scroll:        https://freesound.org/s/485486/\n\
 Button Click:         https://freesound.org/s/478196/\n\
 ";
-        g_theFont->AddVertsForTextInBox2D(textVerts, textBounds, uiDim.y * .026f, text, Rgba8::WHITE, FONT_DEFAULT_ASPECT*.6f, ALIGN_CENTER_LEFT, .03f,FONT_DEFAULT_KERNING);
+        g_theTextLayouts->AddVertsForTextInBox2D(textVerts, textBounds, uiDim.y * .026f, text, Rgba8::WHITE, FONT_DEFAULT_ASPECT*.6f, ALIGN_CENTER_LEFT, .03f,FONT_DEFAULT_KERNING);
     }
 
     if (m_state == GAME_SETTINGS_CALIBRATE) {
@@ -759,14 +766,18 @@ Button Click:         https://freesound.org/s/478196/\n\
 		ParticleSystem2D::gParticleSystem2D->Render();
     }
 
-	g_theRenderer->BindDiffuseTexture(g_theFont->GetTexture());
+	BindTexture(g_theFont->GetTexture());
 	g_theRenderer->DrawVertexArray(textVerts);
 
 	//debug draw
     if (g_isDebugDrawing)
     {
-        std::vector<Vertex_PCU> verts;		
+        std::vector<Vertex_PCU>& verts = g_theFrameVerts->Acquire();
 		std::string text = Stringf("fps: %.1f\n", 1.f/(float)m_gameClock->GetLastDeltaSeconds());;
+		text += Stringf("text layouts: %u (%u hits, %u misses)\n", (unsigned int)g_theTextLayouts->GetLayoutCount(),
+			g_theTextLayouts->GetHitCount(), g_theTextLayouts->GetMissCount());
+		text += Stringf("frame verts: %u buffers, %u reserved, %u grew last frame\n", (unsigned int)g_theFrameVerts->GetBufferCount(),
+			(unsigned int)g_theFrameVerts->GetReservedVertexCount(), g_theFrameVerts->GetLastFrameGrowthCount());
 		switch (m_state)
 		{
 		case GAME_ATTRACT:		text+="Attract\n";		break;
@@ -795,7 +806,7 @@ Button Click:         https://freesound.org/s/478196/\n\
 		}
 
         g_theFont->AddVertsForTextInBox2D(verts, uiBound, uiDim.y * .02f, text, Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_TOP_LEFT, .05f, FONT_DEFAULT_KERNING);
-        g_theRenderer->BindDiffuseTexture(g_theFont->GetTexture());
+        BindTexture(g_theFont->GetTexture());
         g_theRenderer->DrawVertexArray(verts);
     }
 
@@ -0,0 +1,33 @@
+#include "Game/GameAudioSystem.hpp"
+#include "ThirdParty/fmod/fmod.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+FMOD::Sound* GameAudioSystem::CreateSoundHandle(std::string const& soundFilePath)
+{
+    //same mode as CreateOrGetSound so a registered handle plays like any other engine sound
+    FMOD::Sound* sound = nullptr;
+    if (m_fmodSystem->createSound(soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &sound) != FMOD_OK) {
+        return nullptr;
+    }
+    return sound;
+}
+
+//////////////////////////////////////////////////////////////////////////
+SoundID GameAudioSystem::RegisterSoundHandle(std::string const& soundFilePath, FMOD::Sound* sound)
+{
+    std::map<std::string, SoundID>::iterator found = m_registeredSoundIDs.find(soundFilePath);
+    if (found != m_registeredSoundIDs.end()) {  //loaded twice, keep the first
+        if (sound != nullptr) {
+            sound->release();
+        }
+        return found->second;
+    }
+    if (sound == nullptr) {
+        return (SoundID)-1;
+    }
+
+    SoundID soundID = m_registeredSounds.size();
+    m_registeredSoundIDs[soundFilePath] = soundID;
+    m_registeredSounds.push_back(sound);
+    return soundID;
+}
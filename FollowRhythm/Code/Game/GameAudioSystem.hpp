@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+#include "Engine/Audio/AudioSystem.hpp"
+
+namespace FMOD { class Sound; }
+
+//engine audio plus sounds created off the main thread
+//the FMOD system is thread safe, only the engine's sound cache has to stay on the main thread
+class GameAudioSystem : public AudioSystem
+{
+public:
+    FMOD::Sound* CreateSoundHandle(std::string const& soundFilePath);                 //any thread, nullptr on failure
+    SoundID      RegisterSoundHandle(std::string const& soundFilePath, FMOD::Sound* sound); //main thread, takes ownership
+};
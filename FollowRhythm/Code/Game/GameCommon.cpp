@@ -1,12 +1,15 @@
 #include "Game/GameCommon.hpp"
 #include "Engine/Input/XboxController.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
 
 App* g_theApp = nullptr;
 RenderContext* g_theRenderer = nullptr;
 InputSystem* g_theInput = nullptr;
 RandomNumberGenerator* g_theRNG = nullptr;
-AudioSystem* g_theAudio = nullptr;
+GameAudioSystem* g_theAudio = nullptr;
 BitmapFont* g_theFont = nullptr;
+TextLayoutCache* g_theTextLayouts = nullptr;
+FrameVertexArena* g_theFrameVerts = nullptr;
 Game* g_theGame = nullptr;
 
 bool g_isDebugDrawing = false;
@@ -18,4 +21,10 @@ eXboxButtonID gConfirmButton=XBOX_BUTTON_ID_A;
 eXboxButtonID gBackButton = XBOX_BUTTON_ID_BACK;
 eXboxButtonID gPauseButton = XBOX_BUTTON_ID_START;
 
-SoundID gButtonSFXID = 0;
\ No newline at end of file
+SoundID gButtonSFXID = 0;
+
+//////////////////////////////////////////////////////////////////////////
+void BindTexture(Texture const* texture)
+{
+    g_theRenderer->BindDiffuseTexture(texture);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+//timing and scoring rules shared by the game and the headless core, no engine types here
+constexpr unsigned int COMBO_START_COUNT = 5;
+constexpr unsigned int COMBO_SINGLE_RATE_COUNT = 5;
+constexpr unsigned int NOTE_RENDER_MAX_TIME_MS = 3000;
+constexpr unsigned int NOTE_SCORE_DELTA_TIME_MS = 500;
+constexpr float NOTE_RENDER_FINISH_AGE = (float)NOTE_SCORE_DELTA_TIME_MS / (float)NOTE_RENDER_MAX_TIME_MS;
+constexpr float NOTE_RENDER_ATTACK_START_AGE=1.f - NOTE_RENDER_FINISH_AGE;
+constexpr float COMBO_MAX_RATE=5.f;
+constexpr float COMBO_PERFECT_RANK = 85.f;
+constexpr float COMBO_GOOD_RANK = 60.f;
+constexpr float COMBO_FAIR_RANK = 35.f;
+constexpr float INPUT_JOYSTICK_DEAD_Y = .3f;
+constexpr float INPUT_JOYSTICK_INNER_DEAD_ZONE = .3f;     //the engine's AnalogJoystick radial dead zone
+constexpr float INPUT_JOYSTICK_OUTER_DEAD_ZONE = .95f;
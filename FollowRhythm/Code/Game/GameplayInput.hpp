@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum eGameplayInputType : uint8_t
+{
+    GAMEPLAY_INPUT_BUTTON_PRESSED = 0,  //LB/RB
+    GAMEPLAY_INPUT_STICK_MOVED,         //left/right stick y
+};
+
+struct GameplayInputEvent
+{
+    eGameplayInputType type = GAMEPLAY_INPUT_BUTTON_PRESSED;
+    bool isLeft = true;
+    float yValue = 0.f;     //stick only
+    uint32_t timeMS = 0;    //song time when sampled
+};
+
+constexpr size_t GAMEPLAY_INPUT_QUEUE_SIZE = 32;
+
+//fixed size queue of typed gameplay input, filled and drained every frame
+class GameplayInputQueue
+{
+public:
+    bool Push(GameplayInputEvent const& inputEvent);    //false when full, the event is dropped
+    void Clear() { m_count = 0; }
+
+    size_t GetCount() const { return m_count; }
+    GameplayInputEvent const& operator[](size_t index) const { return m_events[index]; }
+
+private:
+    GameplayInputEvent m_events[GAMEPLAY_INPUT_QUEUE_SIZE];
+    size_t m_count = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+inline bool GameplayInputQueue::Push(GameplayInputEvent const& inputEvent)
+{
+    if (m_count >= GAMEPLAY_INPUT_QUEUE_SIZE) {
+        return false;
+    }
+    m_events[m_count++] = inputEvent;
+    return true;
+}
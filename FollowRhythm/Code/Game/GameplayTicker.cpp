@@ -0,0 +1,81 @@
+#include "Game/GameplayTicker.hpp"
+#include "Game/SongTimeline.hpp"
+#include "Game/SongSimulation.hpp"
+#include "Game/ReplayFile.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+void GameplayTicker::SetTickRate(uint32_t ticksPerSecond)
+{
+    //whole ms ticks, song time is in ms everywhere
+    m_tickMS = ticksPerSecond == 0 || ticksPerSecond >= 1000 ? 1 : 1000 / ticksPerSecond;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void GameplayTicker::SetTickMS(uint32_t tickMS)
+{
+    m_tickMS = tickMS == 0 ? 1 : tickMS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void GameplayTicker::Reset(uint32_t timeMS)
+{
+    m_tickedMS = timeMS;
+    m_lastTickCount = 0;
+    m_maxTickCount = 0;
+    m_skippedCount = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32_t GameplayTicker::TickTo(SongTimeline& timeline, uint32_t targetMS, GameplayInputSource& input)
+{
+    //a replay keeps the frame target, not every tick, playback runs the same ticks again
+    ReplayRecorder* recorder = timeline.GetRecorder();
+    if (recorder != nullptr) {
+        recorder->BeginTicks(m_tickMS);
+    }
+
+    uint32_t tickCount = 0;
+    while (targetMS >= m_tickedMS + m_tickMS) {
+        if (tickCount >= GAMEPLAY_MAX_CATCH_UP_TICKS) {
+            //a hitch, land on the last tick before the target at once instead of falling further behind
+            m_tickedMS += (targetMS - m_tickedMS) / m_tickMS * m_tickMS;
+            Step(timeline, m_tickedMS, input);
+            tickCount++;
+            m_skippedCount++;
+            break;
+        }
+        m_tickedMS += m_tickMS;
+        Step(timeline, m_tickedMS, input);
+        tickCount++;
+    }
+
+    if (recorder != nullptr) {
+        recorder->EndTicks(targetMS);
+    }
+
+    m_lastTickCount = tickCount;
+    m_maxTickCount = tickCount > m_maxTickCount ? tickCount : m_maxTickCount;
+    return tickCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void GameplayTicker::FinishAt(SongTimeline& timeline, uint32_t endMS, GameplayInputSource& input)
+{
+    TickTo(timeline, endMS, input);
+    if (endMS > m_tickedMS) {
+        m_tickedMS = endMS;
+        Step(timeline, endMS, input);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void GameplayTicker::Step(SongTimeline& timeline, uint32_t timeMS, GameplayInputSource& input)
+{
+    //same order as a frame used to be: input judged first, then notes that are over retire
+    GameplayInputEvent event;
+    while (input.PopInput(timeMS, event)) {
+        timeline.PushInput(event);
+    }
+    timeline.DispatchInput();
+    timeline.AdvanceTo(timeMS);
+}
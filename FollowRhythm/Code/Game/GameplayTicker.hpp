@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+class SongTimeline;
+class GameplayInputSource;
+
+constexpr uint32_t GAMEPLAY_DEFAULT_TICK_RATE = 1000;
+constexpr uint32_t GAMEPLAY_MAX_CATCH_UP_TICKS = 500;  //past this a long frame is stepped over in one go
+
+//fixed rate gameplay steps under the song clock, a frame runs as many ticks as the clock moved
+//inputs are judged in the tick they fall in and notes retire on tick times, so play is the same at any frame rate
+class GameplayTicker
+{
+public:
+    void SetTickRate(uint32_t ticksPerSecond);
+    void SetTickMS(uint32_t tickMS);    //replays keep the tick length itself
+    void Reset(uint32_t timeMS);    //play start and seeks, ticks line up from here
+
+    uint32_t TickTo(SongTimeline& timeline, uint32_t targetMS, GameplayInputSource& input); //ticks run
+    void     FinishAt(SongTimeline& timeline, uint32_t endMS, GameplayInputSource& input);  //last partial tick
+
+    uint32_t GetTickMS() const          { return m_tickMS; }
+    uint32_t GetTickedMS() const        { return m_tickedMS; }
+    uint32_t GetLastTickCount() const   { return m_lastTickCount; }
+    uint32_t GetMaxTickCount() const    { return m_maxTickCount; }
+    uint32_t GetSkippedCount() const    { return m_skippedCount; }
+
+private:
+    void Step(SongTimeline& timeline, uint32_t timeMS, GameplayInputSource& input);
+
+private:
+    uint32_t m_tickMS = 1000 / GAMEPLAY_DEFAULT_TICK_RATE;
+    uint32_t m_tickedMS = 0;
+    uint32_t m_lastTickCount = 0;   //ticks of the last frame
+    uint32_t m_maxTickCount = 0;    //most ticks one frame needed since Reset
+    uint32_t m_skippedCount = 0;    //frames too long to catch up tick by tick
+};
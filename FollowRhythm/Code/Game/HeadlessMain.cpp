@@ -0,0 +1,202 @@
+//headless driver, plays a chart through the platform-free core with no window, audio or controller
+#include "Game/ChartFile.hpp"
+#include "Game/ChartParser.hpp"
+#include "Game/AutoplayInput.hpp"
+#include "Game/GameplayTicker.hpp"
+#include "Game/ReplayFile.hpp"
+#include "Game/SongTimeline.hpp"
+#include "Game/SongSimulation.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+static void PrintUsage()
+{
+    printf("usage: FollowRhythmHeadless <chart.chart|notes.csv> [--step ms] [--tick hz] [--repeat count]\n");
+    printf("           [--replay file] | [--autoplay [--error ms] [--seed n]] [--record file]\n");
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool LoadChartRecords(std::string const& chartPath, std::vector<ChartNoteRecord>& outRecords)
+{
+    bool isCSV = chartPath.size() > 4 && chartPath.compare(chartPath.size() - 4, 4, ".csv") == 0;
+    if (isCSV) {
+        std::vector<ChartParseError> errors;
+        if (!ReadNotesCSVFile(chartPath, outRecords, errors)) {
+            return false;
+        }
+        for (ChartParseError const& error : errors) {
+            fprintf(stderr, "%s(%u): %s\n", chartPath.c_str(), error.lineNumber, error.message.c_str());
+        }
+        return true;
+    }
+
+    MappedFile chart;
+    if (!chart.Open(chartPath.c_str())) {
+        return false;
+    }
+    uint32_t noteCount = 0;
+    ChartNoteRecord const* records = GetChartRecordsFromMemory(chart.GetData(), chart.GetSize(), noteCount);
+    if (records == nullptr) {
+        return false;
+    }
+    outRecords.assign(records, records + noteCount);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static SongSimulationStats GetReplayStats(ReplayData const& replay)
+{
+    SongSimulationStats stats;
+    for (ReplayRecord const& record : replay.records) {
+        if (record.type == REPLAY_RECORD_ADVANCE || record.type == REPLAY_RECORD_TICK_TO) {
+            stats.stepCount++;
+            stats.endMS = record.timeMS;
+        }
+        else if (record.type != REPLAY_RECORD_SEEK) {
+            stats.inputCount++;
+        }
+    }
+    return stats;
+}
+
+//////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string chartPath = argv[1];
+    uint32_t stepMS = 16;
+    uint32_t tickRate = 0;  //0 judges once per step like a frame without gameplay ticks
+    int repeatCount = 1;
+    std::string replayPath;
+    std::string recordPath;
+    bool isAutoplay = false;
+    float errorStdDevMS = 0.f;
+    uint32_t seed = 0;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+            stepMS = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--tick") == 0 && i + 1 < argc) {
+            tickRate = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--autoplay") == 0) {
+            isAutoplay = true;
+        }
+        else if (strcmp(argv[i], "--error") == 0 && i + 1 < argc) {
+            errorStdDevMS = (float)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeatCount = atoi(argv[++i]);
+            repeatCount = repeatCount < 1 ? 1 : repeatCount;
+        }
+        else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::vector<ChartNoteRecord> records;
+    if (!LoadChartRecords(chartPath, records)) {
+        fprintf(stderr, "loading %s failed\n", chartPath.c_str());
+        return 1;
+    }
+
+    SongTimeline timeline;
+    timeline.Build(records.data(), (uint32_t)records.size());
+
+    ReplayData replay;
+    if (!replayPath.empty()) {
+        if (!ReadReplayFile(replayPath, replay)) {
+            fprintf(stderr, "loading %s failed\n", replayPath.c_str());
+            return 1;
+        }
+        if (replay.header.chartHash != timeline.GetChartHash() || replay.header.noteCount != timeline.GetNoteCount()) {
+            fprintf(stderr, "%s was recorded on a different chart\n", replayPath.c_str());
+            return 1;
+        }
+    }
+
+    ReplayRecorder recorder;
+    if (!recordPath.empty()) {
+        timeline.SetRecorder(&recorder);
+    }
+
+    AutoplayInputSource autoplay;
+    EmptyInputSource noInput;
+    GameplayInputSource* input = &noInput;
+    if (isAutoplay) {
+        autoplay.Build(timeline.GetNoteTable(), 0.f, errorStdDevMS, seed);
+        input = &autoplay;
+    }
+
+    GameplayTicker ticker;
+    ticker.SetTickRate(tickRate);
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    SongSimulationStats stats;
+    ReplayResult replayResult;
+    for (int i = 0; i < repeatCount; i++) {
+        if (!replayPath.empty()) {
+            replayResult = PlayReplay(timeline, replay);
+            stats = GetReplayStats(replay);
+            continue;
+        }
+        FixedStepTimeSource clock(stepMS, timeline.GetEndMS());
+        autoplay.Rewind();
+        stats = SimulateSong(timeline, clock, *input, tickRate > 0 ? &ticker : nullptr);
+    }
+    std::chrono::duration<double, std::milli> wallMS = std::chrono::steady_clock::now() - startTime;
+
+    if (!recordPath.empty() && !WriteReplayFile(recordPath, recorder.GetReplay())) {
+        fprintf(stderr, "writing %s failed\n", recordPath.c_str());
+        return 1;
+    }
+
+    ScoreKeeper const& score = timeline.GetScoreKeeper();
+    double songMS = (double)stats.endMS * (double)repeatCount;
+    printf("%s\n", chartPath.c_str());
+    printf("notes: %u  steps: %u  inputs: %u\n", timeline.GetNoteCount(), stats.stepCount, stats.inputCount);
+    printf("score: %i  max combo: %u  perfect: %u  good: %u  fair: %u  miss: %u\n",
+        score.GetScore(), score.GetMaxCombo(), score.GetPerfectCount(), score.GetGoodCount(), score.GetFairCount(),
+        score.GetMissCount(timeline.GetNoteCount()));
+    printf("song: %.0f ms  wall: %.3f ms  speed: x%.0f\n", songMS, wallMS.count(),
+        wallMS.count() > 0.0 ? songMS / wallMS.count() : 0.0);
+
+    if (!replayPath.empty()) {
+        ReplayResult const& recorded = replay.header.result;
+        bool isMatching = replayResult == recorded;
+        printf("replay %s: recorded score %i  max combo %u  perfect %u  good %u  fair %u\n",
+            isMatching ? "matches" : "DIFFERS", recorded.score, recorded.maxCombo, recorded.perfectCount,
+            recorded.goodCount, recorded.fairCount);
+        return isMatching ? 0 : 2;
+    }
+    if (isAutoplay && errorStdDevMS <= 0.f) {
+        int perfectScore = ScoreKeeper::GetPerfectScore(timeline.GetNoteTable());
+        uint32_t noteCount = timeline.GetNoteCount();
+        bool isPerfect = score.GetPerfectCount() == noteCount && score.GetMaxCombo() == noteCount;
+        //coarser steps retire holds a little late, which shifts the combo multiplier they score with
+        bool isMSAccurate = stepMS <= 1 || (tickRate > 0 && ticker.GetTickMS() <= 1);
+        isPerfect = isPerfect && (!isMSAccurate || score.GetScore() == perfectScore);
+        printf("perfect run %s: theoretical max score %i\n", isPerfect ? "passed" : "FAILED", perfectScore);
+        return isPerfect ? 0 : 3;
+    }
+    return 0;
+}
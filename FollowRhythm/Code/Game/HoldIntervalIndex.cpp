@@ -0,0 +1,68 @@
+#include "Game/HoldIntervalIndex.hpp"
+#include "Game/NoteTable.hpp"
+#include "Game/MonotonicArena.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+void HoldIntervalIndex::Init(NoteTable const& table, MonotonicArena& arena)
+{
+    Clear();
+    for (uint32_t i = 0; i < table.count; i++) {
+        if (table.IsHold(i)) {
+            m_count++;
+        }
+    }
+    if (m_count == 0) {
+        return;
+    }
+
+    m_startMS = arena.AllocateArray<uint32_t>(m_count);
+    m_endMS = arena.AllocateArray<uint32_t>(m_count);
+    m_maxEndMS = arena.AllocateArray<uint32_t>(m_count);
+    m_noteIndex = arena.AllocateArray<uint32_t>(m_count);
+    uint32_t holdIndex = 0;
+    for (uint32_t i = 0; i < table.count; i++) {
+        if (table.IsHold(i)) {
+            m_startMS[holdIndex] = table.startMS[i];
+            m_endMS[holdIndex] = table.startMS[i] + table.duration[i];
+            m_noteIndex[holdIndex] = i;
+            holdIndex++;
+        }
+    }
+
+    //leaves sit on even slots, level k nodes on slots whose lowest k bits are all 1
+    int64_t count = (int64_t)m_count;
+    int64_t lastNode = 0;   //rightmost node of the levels built so far
+    uint32_t lastMaxEnd = 0;
+    for (int64_t i = 0; i < count; i += 2) {
+        lastNode = i;
+        lastMaxEnd = m_maxEndMS[i] = m_endMS[i];
+    }
+
+    int level = 1;
+    for (; ((int64_t)1 << level) <= count; level++) {
+        int64_t childOffset = (int64_t)1 << (level - 1);
+        int64_t firstNode = (childOffset << 1) - 1;
+        int64_t step = childOffset << 2;
+        for (int64_t i = firstNode; i < count; i += step) {
+            uint32_t leftMax = m_maxEndMS[i - childOffset];
+            uint32_t rightMax = i + childOffset < count ? m_maxEndMS[i + childOffset] : lastMaxEnd;
+            uint32_t maxEnd = m_endMS[i];
+            maxEnd = leftMax > maxEnd ? leftMax : maxEnd;
+            maxEnd = rightMax > maxEnd ? rightMax : maxEnd;
+            m_maxEndMS[i] = maxEnd;
+        }
+
+        //move the rightmost node up to its parent
+        lastNode = ((lastNode >> level) & 1) ? lastNode - childOffset : lastNode + childOffset;
+        if (lastNode < count && m_maxEndMS[lastNode] > lastMaxEnd) {
+            lastMaxEnd = m_maxEndMS[lastNode];
+        }
+    }
+    m_rootLevel = level - 1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void HoldIntervalIndex::Clear()
+{
+    *this = HoldIntervalIndex();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct NoteTable;
+class MonotonicArena;
+
+//hold notes as [startMS, startMS + duration) in an implicit augmented interval tree
+//the holds stay in chart order and the tree is laid out in order over that array,
+//every node keeps the max end of its subtree so whole subtrees are skipped
+class HoldIntervalIndex
+{
+public:
+    void Init(NoteTable const& table, MonotonicArena& arena);
+    void Clear();
+
+    //visits the note index of every hold overlapping [beginMS, endMS), in chart order
+    template<typename Visitor>
+    void ForEachOverlap(uint32_t beginMS, uint32_t endMS, Visitor visit) const;
+
+    uint32_t GetHoldCount() const { return m_count; }
+
+private:
+    struct StackNode
+    {
+        int level = 0;
+        int64_t node = 0;
+        bool isLeftDone = false;
+    };
+
+    uint32_t* m_startMS = nullptr;
+    uint32_t* m_endMS = nullptr;
+    uint32_t* m_maxEndMS = nullptr;
+    uint32_t* m_noteIndex = nullptr;
+    uint32_t m_count = 0;
+    int m_rootLevel = -1;
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+void HoldIntervalIndex::ForEachOverlap(uint32_t beginMS, uint32_t endMS, Visitor visit) const
+{
+    if (m_rootLevel < 0 || beginMS >= endMS) {
+        return;
+    }
+
+    int64_t count = (int64_t)m_count;
+    StackNode stack[64];
+    int top = 0;
+    stack[top++] = { m_rootLevel, ((int64_t)1 << m_rootLevel) - 1, false };
+    while (top > 0) {
+        StackNode current = stack[--top];
+        if (current.level <= 3) {   //small subtree, a linear walk is cheaper
+            int64_t first = current.node >> current.level << current.level;
+            int64_t last = first + ((int64_t)1 << (current.level + 1)) - 1;
+            last = last < count ? last : count;
+            for (int64_t i = first; i < last && m_startMS[i] < endMS; i++) {
+                if (beginMS < m_endMS[i]) {
+                    visit(m_noteIndex[i]);
+                }
+            }
+        }
+        else if (!current.isLeftDone) {
+            int64_t left = current.node - ((int64_t)1 << (current.level - 1));  //may be past the end
+            stack[top++] = { current.level, current.node, true };
+            if (left >= count || m_maxEndMS[left] > beginMS) {
+                stack[top++] = { current.level - 1, left, false };
+            }
+        }
+        else if (current.node < count && m_startMS[current.node] < endMS) {
+            if (beginMS < m_endMS[current.node]) {
+                visit(m_noteIndex[current.node]);
+            }
+            stack[top++] = { current.level - 1, current.node + ((int64_t)1 << (current.level - 1)), false };
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include "Game/InputSampler.hpp"
+#include "Game/GameplayConstants.hpp"
+#include <chrono>
+#include <cmath>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <Xinput.h>
+#pragma comment(lib, "xinput9_1_0")
+#pragma comment(lib, "winmm")
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+double GetInputClockSeconds()
+{
+    static std::chrono::steady_clock::time_point const sStartTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - sStartTime;
+    return elapsed.count();
+}
+
+//////////////////////////////////////////////////////////////////////////
+static float GetCorrectedStickY(short rawX, short rawY)
+{
+    //same radial dead zone as AnalogJoystick, so the sampler and the frame poll agree on pushed
+    float x = rawX < 0 ? (float)rawX / 32768.f : (float)rawX / 32767.f;
+    float y = rawY < 0 ? (float)rawY / 32768.f : (float)rawY / 32767.f;
+    float magnitude = sqrtf(x * x + y * y);
+    if (magnitude <= INPUT_JOYSTICK_INNER_DEAD_ZONE) {
+        return 0.f;
+    }
+
+    float corrected = (magnitude - INPUT_JOYSTICK_INNER_DEAD_ZONE) / (INPUT_JOYSTICK_OUTER_DEAD_ZONE - INPUT_JOYSTICK_INNER_DEAD_ZONE);
+    corrected = corrected > 1.f ? 1.f : corrected;
+    return y * corrected / magnitude;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static int GetStickZone(float yValue)
+{
+    if (yValue > INPUT_JOYSTICK_DEAD_Y) {
+        return 1;
+    }
+    if (yValue < -INPUT_JOYSTICK_DEAD_Y) {
+        return -1;
+    }
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+InputSampler::~InputSampler()
+{
+    Stop();
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool InputSampler::Start(int controllerIndex, int sampleRateHz)
+{
+    if (m_isRunning) {
+        return true;
+    }
+
+#if defined(_WIN32)
+    if (sampleRateHz <= 0) {
+        return false;
+    }
+
+    GetInputClockSeconds();    //pin the clock origin before the thread uses it
+    DiscardEvents();
+    m_droppedCount = 0;
+    m_isQuitting = false;
+    m_thread = std::thread(&InputSampler::SamplerMain, this, controllerIndex, sampleRateHz);
+    m_isRunning = true;
+    return true;
+#else
+    (void)controllerIndex;
+    (void)sampleRateHz;
+    return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+void InputSampler::Stop()
+{
+    if (!m_isRunning) {
+        return;
+    }
+
+    m_isQuitting = true;
+    m_thread.join();
+    m_isRunning = false;
+    DiscardEvents();
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool InputSampler::PopEvent(SampledInputEvent& outEvent)
+{
+    return m_events.Pop(outEvent);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void InputSampler::DiscardEvents()
+{
+    SampledInputEvent dropped;
+    while (m_events.Pop(dropped)) {
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void InputSampler::PushEvent(SampledInputEvent const& inputEvent)
+{
+    if (!m_events.Push(inputEvent)) {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void InputSampler::SamplerMain(int controllerIndex, int sampleRateHz)
+{
+#if defined(_WIN32)
+    timeBeginPeriod(1);     //default scheduler tick is ~15ms, far coarser than the sample rate
+
+    std::chrono::duration<double> const period(1.0 / (double)sampleRateHz);
+    std::chrono::steady_clock::time_point nextPoll = std::chrono::steady_clock::now();
+    WORD lastButtons = 0;
+    int lastZones[2] = { 0, 0 };
+    bool wasConnected = false;
+
+    while (!m_isQuitting) {
+        XINPUT_STATE state = {};
+        bool isConnected = XInputGetState((DWORD)controllerIndex, &state) == ERROR_SUCCESS;
+        double timeSeconds = GetInputClockSeconds();
+        if (isConnected) {
+            XINPUT_GAMEPAD const& pad = state.Gamepad;
+            WORD pressed = wasConnected ? (WORD)(pad.wButtons & ~lastButtons) : 0;
+            lastButtons = pad.wButtons;
+
+            SampledInputEvent inputEvent;
+            inputEvent.timeSeconds = timeSeconds;
+            inputEvent.type = GAMEPLAY_INPUT_BUTTON_PRESSED;
+            if (pressed & XINPUT_GAMEPAD_LEFT_SHOULDER) {
+                inputEvent.isLeft = true;
+                PushEvent(inputEvent);
+            }
+            if (pressed & XINPUT_GAMEPAD_RIGHT_SHOULDER) {
+                inputEvent.isLeft = false;
+                PushEvent(inputEvent);
+            }
+
+            //only zone changes matter for holds, the sampler is the only stick source while it runs
+            float yValues[2] = { GetCorrectedStickY(pad.sThumbLX, pad.sThumbLY), GetCorrectedStickY(pad.sThumbRX, pad.sThumbRY) };
+            inputEvent.type = GAMEPLAY_INPUT_STICK_MOVED;
+            for (int i = 0; i < 2; i++) {
+                int zone = GetStickZone(yValues[i]);
+                if (zone != lastZones[i]) {
+                    lastZones[i] = zone;
+                    inputEvent.isLeft = i == 0;
+                    inputEvent.yValue = yValues[i];
+                    PushEvent(inputEvent);
+                }
+            }
+        }
+        wasConnected = isConnected;
+
+        //sleep to the next tick, never try to catch up on missed ones
+        nextPoll += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (nextPoll < now) {
+            nextPoll = now;
+        }
+        std::this_thread::sleep_until(nextPoll);
+    }
+
+    timeEndPeriod(1);
+#else
+    (void)controllerIndex;
+    (void)sampleRateHz;
+#endif
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Game/GameplayInput.hpp"
+#include "Game/SPSCQueue.hpp"
+#include <atomic>
+#include <thread>
+
+constexpr size_t INPUT_SAMPLER_QUEUE_SIZE = 256;
+
+//gameplay input edge stamped on the sampler thread
+struct SampledInputEvent
+{
+    eGameplayInputType type = GAMEPLAY_INPUT_BUTTON_PRESSED;
+    bool isLeft = true;
+    float yValue = 0.f;
+    double timeSeconds = 0.0;   //GetInputClockSeconds
+};
+
+double GetInputClockSeconds();  //high resolution monotonic clock shared by the sampler and the song clock
+
+//polls the controller on its own thread so presses are timed finer than a frame
+//only LB/RB presses and stick zone changes are pushed, the game thread drains them each frame
+class InputSampler
+{
+public:
+    InputSampler() = default;
+    ~InputSampler();
+    InputSampler(InputSampler const&) = delete;
+    InputSampler& operator=(InputSampler const&) = delete;
+
+    bool Start(int controllerIndex, int sampleRateHz);  //false if polling is not supported here
+    void Stop();
+    bool IsRunning() const { return m_isRunning; }
+
+    bool     PopEvent(SampledInputEvent& outEvent);
+    void     DiscardEvents();
+    uint32_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    void SamplerMain(int controllerIndex, int sampleRateHz);
+    void PushEvent(SampledInputEvent const& inputEvent);
+
+private:
+    std::thread m_thread;
+    std::atomic<bool> m_isQuitting{ false };
+    std::atomic<uint32_t> m_droppedCount{ 0 };
+    bool m_isRunning = false;
+    SPSCQueue<SampledInputEvent, INPUT_SAMPLER_QUEUE_SIZE> m_events;
+};
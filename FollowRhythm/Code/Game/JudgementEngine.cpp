@@ -0,0 +1,189 @@
+#include "Game/JudgementEngine.hpp"
+#include "Game/NoteTable.hpp"
+#include "Game/MonotonicArena.hpp"
+#include "Game/GameplayConstants.hpp"
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////////////////////////////////////////////////
+uint8_t JudgementEngine::GetLaneForNote(NoteTable const& table, size_t noteIndex)
+{
+    bool isLeft = table.IsLeft(noteIndex);
+    if (!table.IsHold(noteIndex)) {
+        return isLeft ? JUDGEMENT_LANE_LEFT_SINGLE : JUDGEMENT_LANE_RIGHT_SINGLE;
+    }
+    if (table.isUp[noteIndex]) {
+        return isLeft ? JUDGEMENT_LANE_LEFT_HOLD_UP : JUDGEMENT_LANE_RIGHT_HOLD_UP;
+    }
+    return isLeft ? JUDGEMENT_LANE_LEFT_HOLD_DOWN : JUDGEMENT_LANE_RIGHT_HOLD_DOWN;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool JudgementEngine::JudgeHoldEnd(NoteTable const& table, size_t noteIndex, uint32_t timeMS, Judgement& outJudgement)
+{
+    uint8_t hitState = table.hitState[noteIndex];
+    if (hitState == NOTE_HIT_NONE) {
+        return false;
+    }
+
+    uint32_t actualEnd = hitState == NOTE_HIT_RELEASED ? table.actualEndMS[noteIndex] : timeMS;
+    outJudgement.type = JUDGEMENT_HOLD_SCORED;
+    outJudgement.noteIndex = (uint32_t)noteIndex;
+    outJudgement.rank = GetHoldRank(actualEnd - table.actualStartMS[noteIndex], table.duration[noteIndex]);
+    outJudgement.deltaMS = 0.f;
+    outJudgement.multiplier = GetHoldMultiplier(table.duration[noteIndex]);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+float JudgementEngine::GetHoldRank(uint32_t heldMS, uint32_t duration)
+{
+    float score = (float)heldMS / (float)duration - 1.f;
+    score = 1.f - fabsf(score);
+    return score * score * 100.f;
+}
+
+//////////////////////////////////////////////////////////////////////////
+float JudgementEngine::GetHoldMultiplier(uint32_t duration)
+{
+    float multiplier = (float)duration * .007f;
+    return multiplier < 2.f ? 2.f : (multiplier > 4.f ? 4.f : multiplier);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void JudgementEngine::Init(NoteTable const& table, MonotonicArena& arena)
+{
+    Clear();
+    for (uint32_t i = 0; i < table.count; i++) {
+        m_laneCounts[GetLaneForNote(table, i)]++;
+    }
+    for (int lane = 0; lane < NUM_JUDGEMENT_LANES; lane++) {
+        m_laneNotes[lane] = arena.AllocateArray<uint32_t>(m_laneCounts[lane]);
+        m_laneMaxRenderEndMS[lane] = arena.AllocateArray<uint32_t>(m_laneCounts[lane]);
+    }
+
+    uint32_t filled[NUM_JUDGEMENT_LANES] = {};
+    uint32_t maxRenderEndMS[NUM_JUDGEMENT_LANES] = {};
+    for (uint32_t i = 0; i < table.count; i++) {
+        uint8_t lane = GetLaneForNote(table, i);
+        maxRenderEndMS[lane] = std::max(maxRenderEndMS[lane], table.renderEndMS[i]);
+        m_laneMaxRenderEndMS[lane][filled[lane]] = maxRenderEndMS[lane];
+        m_laneNotes[lane][filled[lane]++] = i;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void JudgementEngine::Clear()
+{
+    *this = JudgementEngine();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void JudgementEngine::Reset()
+{
+    for (int lane = 0; lane < NUM_JUDGEMENT_LANES; lane++) {
+        m_laneCursors[lane] = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void JudgementEngine::Seek(uint32_t timeMS)
+{
+    //first note of each lane still on screen, same rule as GetLaneFront so a long hold can still be grabbed
+    //the running max first passes timeMS exactly at that note
+    for (int lane = 0; lane < NUM_JUDGEMENT_LANES; lane++) {
+        uint32_t const* maxEnds = m_laneMaxRenderEndMS[lane];
+        m_laneCursors[lane] = (uint32_t)(std::upper_bound(maxEnds, maxEnds + m_laneCounts[lane], timeMS) - maxEnds);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool JudgementEngine::JudgePress(NoteTable& table, bool isLeft, uint32_t timeMS, float delayMS, Judgement& outJudgement)
+{
+    uint8_t lane = isLeft ? JUDGEMENT_LANE_LEFT_SINGLE : JUDGEMENT_LANE_RIGHT_SINGLE;
+    uint32_t const* front = GetLaneFront(table, lane, timeMS);
+    if (front == nullptr) {
+        return false;
+    }
+
+    uint32_t noteIndex = *front;
+    if (timeMS < table.renderBeginMS[noteIndex]) {  //not on screen yet
+        return false;
+    }
+
+    float delta = (float)timeMS - (float)table.startMS[noteIndex];
+    float score = fabsf(delta - delayMS) / (float)NOTE_SCORE_DELTA_TIME_MS;
+    if (score >= 1.f) {
+        return false;
+    }
+
+    table.hitState[noteIndex] = NOTE_HIT_HIT;
+    m_laneCursors[lane]++;
+
+    outJudgement.type = JUDGEMENT_SINGLE_HIT;
+    outJudgement.noteIndex = noteIndex;
+    outJudgement.rank = (1.f - score) * 100.f;
+    outJudgement.deltaMS = delta;
+    outJudgement.multiplier = 1.f;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+size_t JudgementEngine::JudgeStick(NoteTable& table, bool isLeft, float yValue, uint32_t timeMS, Judgement* outJudgements)
+{
+    size_t judgementCount = 0;
+    bool isInDeadZone = fabsf(yValue) < INPUT_JOYSTICK_DEAD_Y;
+    uint8_t lanes[2] = {
+        (uint8_t)(isLeft ? JUDGEMENT_LANE_LEFT_HOLD_UP : JUDGEMENT_LANE_RIGHT_HOLD_UP),
+        (uint8_t)(isLeft ? JUDGEMENT_LANE_LEFT_HOLD_DOWN : JUDGEMENT_LANE_RIGHT_HOLD_DOWN)
+    };
+    float directions[2] = { 1.f, -1.f };
+
+    for (int i = 0; i < 2; i++) {
+        uint32_t const* front = GetLaneFront(table, lanes[i], timeMS);
+        if (front == nullptr) {
+            continue;
+        }
+
+        uint32_t noteIndex = *front;
+        bool isPushed = !isInDeadZone && directions[i] * yValue > 0.f;
+        Judgement& judgement = outJudgements[judgementCount];
+        judgement.noteIndex = noteIndex;
+        if (table.hitState[noteIndex] == NOTE_HIT_HIT && !isPushed) {
+            uint32_t endMS = table.startMS[noteIndex] + table.duration[noteIndex];
+            table.actualEndMS[noteIndex] = timeMS < endMS ? timeMS : endMS;
+            table.hitState[noteIndex] = NOTE_HIT_RELEASED;
+            m_laneCursors[lanes[i]]++;
+            judgement.type = JUDGEMENT_HOLD_RELEASED;
+            judgementCount++;
+        }
+        else if (table.hitState[noteIndex] == NOTE_HIT_NONE && isPushed && timeMS >= table.renderBeginMS[noteIndex] &&
+            (float)table.startMS[noteIndex] - (float)timeMS <= (float)NOTE_SCORE_DELTA_TIME_MS) {
+            table.actualStartMS[noteIndex] = timeMS;
+            table.hitState[noteIndex] = NOTE_HIT_HIT;
+            judgement.type = JUDGEMENT_HOLD_PRESSED;
+            judgementCount++;
+        }
+    }
+    return judgementCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32_t const* JudgementEngine::GetLaneFront(NoteTable const& table, uint8_t lane, uint32_t timeMS)
+{
+    //drop notes that left the screen, each note is dropped once
+    //a held note still takes its release on its last millisecond
+    uint32_t const* notes = m_laneNotes[lane];
+    uint32_t& cursor = m_laneCursors[lane];
+    while (cursor < m_laneCounts[lane] && table.renderEndMS[notes[cursor]] <= timeMS) {
+        uint32_t noteIndex = notes[cursor];
+        if (table.renderEndMS[noteIndex] == timeMS && table.IsHold(noteIndex) && table.hitState[noteIndex] == NOTE_HIT_HIT) {
+            break;
+        }
+        cursor++;
+    }
+    if (cursor >= m_laneCounts[lane]) {
+        return nullptr;
+    }
+    return &notes[cursor];
+}
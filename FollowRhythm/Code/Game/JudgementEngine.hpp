@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct NoteTable;
+class MonotonicArena;
+
+enum eJudgementLane : uint8_t
+{
+    JUDGEMENT_LANE_LEFT_SINGLE = 0,
+    JUDGEMENT_LANE_RIGHT_SINGLE,
+    JUDGEMENT_LANE_LEFT_HOLD_UP,
+    JUDGEMENT_LANE_RIGHT_HOLD_UP,
+    JUDGEMENT_LANE_LEFT_HOLD_DOWN,
+    JUDGEMENT_LANE_RIGHT_HOLD_DOWN,
+    NUM_JUDGEMENT_LANES
+};
+
+enum eJudgementType : uint8_t
+{
+    JUDGEMENT_NONE = 0,
+    JUDGEMENT_SINGLE_HIT,
+    JUDGEMENT_HOLD_PRESSED,
+    JUDGEMENT_HOLD_RELEASED,
+    JUDGEMENT_HOLD_SCORED,
+};
+
+struct Judgement
+{
+    eJudgementType type = JUDGEMENT_NONE;
+    uint32_t noteIndex = 0;
+    float rank = 0.f;           //0~100, only when scored
+    float deltaMS = 0.f;        //press time - note start, single hits only
+    float multiplier = 1.f;     //hold length bonus
+
+    bool IsScored() const { return type == JUDGEMENT_SINGLE_HIT || type == JUDGEMENT_HOLD_SCORED; }
+};
+
+//pending notes of every lane in time order, an input only ever looks at the front of its lane
+//notes leave a lane once judged or once their window is over, so each note is visited O(1) times
+class JudgementEngine
+{
+public:
+    static uint8_t GetLaneForNote(NoteTable const& table, size_t noteIndex);
+    static bool    JudgeHoldEnd(NoteTable const& table, size_t noteIndex, uint32_t timeMS, Judgement& outJudgement);
+    static float   GetHoldRank(uint32_t heldMS, uint32_t duration);
+    static float   GetHoldMultiplier(uint32_t duration);
+
+    void Init(NoteTable const& table, MonotonicArena& arena);
+    void Clear();
+    void Reset();
+    void Seek(uint32_t timeMS);
+
+    bool   JudgePress(NoteTable& table, bool isLeft, uint32_t timeMS, float delayMS, Judgement& outJudgement);
+    size_t JudgeStick(NoteTable& table, bool isLeft, float yValue, uint32_t timeMS, Judgement* outJudgements); //up to 2
+
+    uint32_t GetLaneCursor(uint8_t lane) const { return m_laneCursors[lane]; }
+
+private:
+    uint32_t const* GetLaneFront(NoteTable const& table, uint8_t lane, uint32_t timeMS);
+
+private:
+    uint32_t* m_laneNotes[NUM_JUDGEMENT_LANES] = {};
+    uint32_t* m_laneMaxRenderEndMS[NUM_JUDGEMENT_LANES] = {};  //running max over the lane, sorted even when holds overlap
+    uint32_t  m_laneCounts[NUM_JUDGEMENT_LANES] = {};
+    uint32_t  m_laneCursors[NUM_JUDGEMENT_LANES] = {};
+};
@@ -0,0 +1,133 @@
+#include "Game/MonotonicArena.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+static size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+MonotonicArena::MonotonicArena(size_t defaultBlockSize)
+    : m_defaultBlockSize(defaultBlockSize)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+MonotonicArena::~MonotonicArena()
+{
+    Release();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MonotonicArena::Reserve(size_t byteCount)
+{
+    if (!m_blocks.empty()) {
+        Block const& block = m_blocks[m_currentBlock];
+        if (AlignUp(block.used, alignof(std::max_align_t)) + byteCount <= block.size) {
+            return;
+        }
+    }
+    AddBlock(byteCount);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void* MonotonicArena::Allocate(size_t byteCount, size_t alignment)
+{
+    //alignment must be a power of two no larger than the block alignment
+    if (alignment > alignof(std::max_align_t)) {
+        return nullptr;
+    }
+
+    while (m_currentBlock < m_blocks.size()) {
+        Block& block = m_blocks[m_currentBlock];
+        size_t offset = AlignUp(block.used, alignment);
+        if (offset + byteCount <= block.size) {
+            block.used = offset + byteCount;
+            return block.data + offset;
+        }
+        if (m_currentBlock + 1 == m_blocks.size()) {
+            break;
+        }
+        m_currentBlock++;   //blocks after a rewind are empty but may be too small
+    }
+
+    AddBlock(byteCount);
+    Block& block = m_blocks[m_currentBlock];
+    block.used = byteCount;
+    return block.data;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ArenaMarker MonotonicArena::GetMarker() const
+{
+    ArenaMarker marker;
+    if (!m_blocks.empty()) {
+        marker.blockIndex = m_currentBlock;
+        marker.offset = m_blocks[m_currentBlock].used;
+    }
+    return marker;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MonotonicArena::RewindToMarker(ArenaMarker const& marker)
+{
+    if (m_blocks.empty()) {
+        return;
+    }
+
+    for (size_t i = marker.blockIndex + 1; i < m_blocks.size(); i++) {
+        m_blocks[i].used = 0;
+    }
+    m_currentBlock = marker.blockIndex;
+    m_blocks[m_currentBlock].used = marker.offset;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MonotonicArena::Reset()
+{
+    RewindToMarker(ArenaMarker());
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MonotonicArena::Release()
+{
+    for (Block& block : m_blocks) {
+        delete[] block.data;
+    }
+    m_blocks.clear();
+    m_blocks.shrink_to_fit();
+    m_currentBlock = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+size_t MonotonicArena::GetUsedBytes() const
+{
+    size_t usedBytes = 0;
+    for (Block const& block : m_blocks) {
+        usedBytes += block.used;
+    }
+    return usedBytes;
+}
+
+//////////////////////////////////////////////////////////////////////////
+size_t MonotonicArena::GetReservedBytes() const
+{
+    size_t reservedBytes = 0;
+    for (Block const& block : m_blocks) {
+        reservedBytes += block.size;
+    }
+    return reservedBytes;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MonotonicArena::AddBlock(size_t minSize)
+{
+    Block block;
+    block.size = minSize > m_defaultBlockSize ? minSize : m_defaultBlockSize;
+    block.data = new uint8_t[block.size];
+
+    //keep the new block right after the current one so rewinding stays ordered
+    size_t insertIndex = m_blocks.empty() ? 0 : m_currentBlock + 1;
+    m_blocks.insert(m_blocks.begin() + insertIndex, block);
+    m_currentBlock = insertIndex;
+}
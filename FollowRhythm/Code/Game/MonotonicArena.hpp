@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+struct ArenaMarker
+{
+    size_t blockIndex = 0;
+    size_t offset = 0;
+};
+
+//bump allocator, memory only goes back in one piece through Rewind/Reset/Release
+//blocks are kept on rewind so a restarted session allocates nothing new
+class MonotonicArena
+{
+public:
+    explicit MonotonicArena(size_t defaultBlockSize = 64 * 1024);
+    ~MonotonicArena();
+    MonotonicArena(MonotonicArena const&) = delete;
+    MonotonicArena& operator=(MonotonicArena const&) = delete;
+
+    void  Reserve(size_t byteCount);    //makes sure the next byteCount bytes fit in one block
+    void* Allocate(size_t byteCount, size_t alignment = alignof(std::max_align_t));
+
+    //zero filled, only for types that need no destructor
+    template<typename T>
+    T* AllocateArray(size_t count);
+
+    ArenaMarker GetMarker() const;
+    void RewindToMarker(ArenaMarker const& marker);
+    void Reset();       //rewind everything, keep the blocks
+    void Release();     //give all blocks back to the heap
+
+    size_t GetUsedBytes() const;
+    size_t GetReservedBytes() const;
+
+private:
+    struct Block
+    {
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    void AddBlock(size_t minSize);
+
+private:
+    std::vector<Block> m_blocks;
+    size_t m_currentBlock = 0;
+    size_t m_defaultBlockSize = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T>
+T* MonotonicArena::AllocateArray(size_t count)
+{
+    static_assert(std::is_trivially_destructible<T>::value, "arena never runs destructors");
+    if (count == 0) {
+        return nullptr;
+    }
+
+    void* memory = Allocate(sizeof(T) * count, alignof(T));
+    memset(memory, 0, sizeof(T) * count);
+    return (T*)memory;
+}
@@ -1,32 +1,15 @@
 #pragma once
 
-#include "Game/Note.hpp"
-#include "Engine/Core/EventSystem.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
-class Timer;
-class Emitter2D;
+struct AABB2;
+struct NoteTable;
+struct Judgement;
+struct Vertex_PCU;
 
-class MultiNotes : public Note
-{
-public:
-    MultiNotes(Song* song, bool isLeft, bool isUp, unsigned int startMS, unsigned int duration);
-    ~MultiNotes() = default;
-
-    void StartToSee() override;
-    void EndToSee() override;
-    void Render(AABB2 const& bounds) const override;
-
-    unsigned int GetRenderBeginMS() const override;
-    unsigned int GetRenderEndMS() const override;
-    bool IsScored() const override;
-
-    bool HandleJoystickMoved(EventArgs& args);
-
-private:
-    unsigned int m_duration = 0;
-    bool m_isUp = true;
-    unsigned int m_actualStart = 0;
-    unsigned int m_actualEnd = 0;
-    Emitter2D* m_emitter = nullptr;
-};
\ No newline at end of file
+//hold notes are rows of NoteTable with a duration
+void AppendVertsForHoldNote(std::vector<Vertex_PCU>& verts, NoteTable const& table, size_t noteIndex, uint32_t elapsedMS,
+    AABB2 const& bounds);   //tail then head, monster sheet uvs
+void UpdateHoldNoteEffect(NoteTable& table, Judgement const& judgement);  //particles for press, release and score
\ No newline at end of file
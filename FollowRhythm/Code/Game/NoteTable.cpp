@@ -0,0 +1,97 @@
+#include "Game/NoteTable.hpp"
+#include "Game/ChartFile.hpp"
+#include "Game/GameplayConstants.hpp"
+#include "Game/MonotonicArena.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+size_t NoteTable::GetChartBytes(uint32_t noteCount)
+{
+    size_t padding = alignof(std::max_align_t);
+    return 4 * (noteCount * sizeof(uint32_t) + padding) + 2 * (noteCount * sizeof(uint8_t) + padding);
+}
+
+//////////////////////////////////////////////////////////////////////////
+size_t NoteTable::GetPlayStateBytes(uint32_t noteCount)
+{
+    size_t padding = alignof(std::max_align_t);
+    return (noteCount * sizeof(uint8_t) + padding) + 2 * (noteCount * sizeof(uint32_t) + padding) +
+        (noteCount * sizeof(Emitter2D*) + padding);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void NoteTable::Build(ChartNoteRecord const* records, uint32_t noteCount, MonotonicArena& arena)
+{
+    Clear();
+    count = noteCount;
+    startMS = arena.AllocateArray<uint32_t>(noteCount);
+    duration = arena.AllocateArray<uint32_t>(noteCount);
+    renderBeginMS = arena.AllocateArray<uint32_t>(noteCount);
+    renderEndMS = arena.AllocateArray<uint32_t>(noteCount);
+    lane = arena.AllocateArray<uint8_t>(noteCount);
+    isUp = arena.AllocateArray<uint8_t>(noteCount);
+
+    for (uint32_t i = 0; i < noteCount; i++) {
+        ChartNoteRecord const& record = records[i];
+        startMS[i] = record.startMS;
+        duration[i] = record.duration;
+        renderBeginMS[i] = GetNoteRenderBeginMS(record.startMS);
+        renderEndMS[i] = GetNoteRenderEndMS(record.startMS, record.duration);
+        lane[i] = record.IsLeft() ? NOTE_LANE_LEFT : NOTE_LANE_RIGHT;
+        isUp[i] = record.IsUp() ? 1 : 0;
+
+        uint32_t renderSpan = renderEndMS[i] - renderBeginMS[i];
+        if (record.duration == 0 && renderSpan > maxSingleRenderSpanMS) {
+            maxSingleRenderSpanMS = renderSpan;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void NoteTable::AllocatePlayState(MonotonicArena& arena)
+{
+    hitState = arena.AllocateArray<uint8_t>(count);
+    actualStartMS = arena.AllocateArray<uint32_t>(count);
+    actualEndMS = arena.AllocateArray<uint32_t>(count);
+    emitters = arena.AllocateArray<Emitter2D*>(count);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void NoteTable::Clear()
+{
+    *this = NoteTable();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void NoteTable::ResetPlayState(size_t index)
+{
+    hitState[index] = NOTE_HIT_NONE;
+    actualStartMS[index] = 0;
+    actualEndMS[index] = 0;
+    emitters[index] = nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32_t GetNoteRenderBeginMS(uint32_t startMS)
+{
+    if (startMS < NOTE_RENDER_MAX_TIME_MS) {
+        return 0;
+    }
+
+    return startMS - NOTE_RENDER_MAX_TIME_MS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32_t GetNoteRenderEndMS(uint32_t startMS, uint32_t duration)
+{
+    if (duration == 0) {    //single note stays hittable after the hit line
+        return startMS + NOTE_SCORE_DELTA_TIME_MS;
+    }
+
+    return startMS + duration;
+}
+
+//////////////////////////////////////////////////////////////////////////
+float GetNoteAgeAtTimeMS(uint32_t startMS, uint32_t elapsedMS)
+{
+    return ((float)(elapsedMS + NOTE_RENDER_MAX_TIME_MS) - (float)startMS) / (float)NOTE_RENDER_MAX_TIME_MS;
+}
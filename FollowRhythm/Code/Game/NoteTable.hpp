@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct ChartNoteRecord;
+class Emitter2D;
+class MonotonicArena;
+
+enum eNoteLane : uint8_t
+{
+    NOTE_LANE_LEFT = 0,
+    NOTE_LANE_RIGHT,
+};
+
+enum eNoteHitState : uint8_t
+{
+    NOTE_HIT_NONE = 0,
+    NOTE_HIT_HIT,       //single note hit, or hold note pressed
+    NOTE_HIT_RELEASED,  //hold note let go
+};
+
+//all notes of a song as parallel arrays, sorted by start time
+//arrays live in the song's arena, the table never frees them
+struct NoteTable
+{
+    uint32_t  count = 0;
+    uint32_t  maxSingleRenderSpanMS = 0;    //longest render end - render begin of a single note
+    uint32_t* startMS = nullptr;
+    uint32_t* duration = nullptr;       //0 for single notes
+    uint32_t* renderBeginMS = nullptr;
+    uint32_t* renderEndMS = nullptr;
+    uint8_t*  lane = nullptr;           //eNoteLane
+    uint8_t*  isUp = nullptr;           //only for hold notes
+
+    //play session state, reallocated from the arena on every start
+    uint8_t*    hitState = nullptr;     //eNoteHitState
+    uint32_t*   actualStartMS = nullptr;
+    uint32_t*   actualEndMS = nullptr;
+    Emitter2D** emitters = nullptr;
+
+    static size_t GetChartBytes(uint32_t noteCount);
+    static size_t GetPlayStateBytes(uint32_t noteCount);
+
+    size_t GetCount() const             { return count; }
+    bool   IsHold(size_t index) const   { return duration[index] != 0; }
+    bool   IsLeft(size_t index) const   { return lane[index] == NOTE_LANE_LEFT; }
+    bool   IsScored(size_t index) const { return hitState[index] != NOTE_HIT_NONE; }
+
+    void Build(ChartNoteRecord const* records, uint32_t noteCount, MonotonicArena& arena);
+    void AllocatePlayState(MonotonicArena& arena);
+    void Clear();
+    void ResetPlayState(size_t index);
+};
+
+uint32_t GetNoteRenderBeginMS(uint32_t startMS);
+uint32_t GetNoteRenderEndMS(uint32_t startMS, uint32_t duration);
+float    GetNoteAgeAtTimeMS(uint32_t startMS, uint32_t elapsedMS);    //1 when the note reaches the hit line
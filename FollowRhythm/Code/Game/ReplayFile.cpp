@@ -0,0 +1,266 @@
+#include "Game/ReplayFile.hpp"
+#include "Game/ChartFile.hpp"
+#include "Game/GameplayInput.hpp"
+#include "Game/GameplayTicker.hpp"
+#include "Game/ScoreKeeper.hpp"
+#include "Game/SongSimulation.hpp"
+#include "Game/SongTimeline.hpp"
+#include <cstring>
+#include <fstream>
+
+//////////////////////////////////////////////////////////////////////////
+bool ReplayResult::operator==(ReplayResult const& other) const
+{
+    return score == other.score && maxCombo == other.maxCombo && perfectCount == other.perfectCount &&
+        goodCount == other.goodCount && fairCount == other.fairCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::Begin(uint32_t noteCount, uint64_t chartHash, float pressDelayMS)
+{
+    m_replay.header = ReplayFileHeader();
+    m_replay.header.noteCount = noteCount;
+    m_replay.header.chartHash = chartHash;
+    m_replay.header.pressDelayMS = pressDelayMS;
+    m_replay.records.clear();   //keeps the capacity of the last session
+    m_firstPendingRecord = 0;
+    m_isRecording = true;
+    m_isTicking = false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::RecordInput(GameplayInputEvent const& input)
+{
+    if (!m_isRecording) {
+        return;
+    }
+
+    ReplayRecord record;
+    record.timeMS = input.timeMS;
+    record.type = input.type == GAMEPLAY_INPUT_BUTTON_PRESSED ? REPLAY_RECORD_BUTTON_PRESSED : REPLAY_RECORD_STICK_MOVED;
+    record.isLeft = input.isLeft ? 1 : 0;
+    record.yValue = input.yValue;
+    m_replay.records.push_back(record);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::RecordAdvance(uint32_t timeMS)
+{
+    if (!m_isRecording) {
+        return;
+    }
+
+    SetPendingDispatchMS(timeMS);
+    if (m_isTicking) {
+        return;
+    }
+    ReplayRecord record;
+    record.timeMS = timeMS;
+    record.type = REPLAY_RECORD_ADVANCE;
+    m_replay.records.push_back(record);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::RecordSeek(uint32_t timeMS)
+{
+    if (!m_isRecording) {
+        return;
+    }
+
+    ReplayRecord record;
+    record.timeMS = timeMS;
+    record.type = REPLAY_RECORD_SEEK;
+    m_replay.records.push_back(record);
+    m_firstPendingRecord = m_replay.records.size();    //inputs before a seek are judged before it
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::BeginTicks(uint32_t tickMS)
+{
+    m_replay.header.tickMS = tickMS;
+    m_isTicking = true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::EndTicks(uint32_t targetMS)
+{
+    m_isTicking = false;
+    if (!m_isRecording) {
+        return;
+    }
+
+    ReplayRecord record;
+    record.timeMS = targetMS;
+    record.type = REPLAY_RECORD_TICK_TO;
+    m_replay.records.push_back(record);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::SetPendingDispatchMS(uint32_t timeMS)
+{
+    for (size_t i = m_firstPendingRecord; i < m_replay.records.size(); i++) {
+        m_replay.records[i].dispatchMS = timeMS;
+    }
+    m_firstPendingRecord = m_replay.records.size();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayRecorder::End(ScoreKeeper const& scoreKeeper)
+{
+    if (!m_isRecording) {
+        return;
+    }
+
+    m_replay.header.result = GetReplayResult(scoreKeeper);
+    m_replay.header.recordCount = (uint32_t)m_replay.records.size();
+    m_isRecording = false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ReplayResult GetReplayResult(ScoreKeeper const& scoreKeeper)
+{
+    ReplayResult result;
+    result.score = scoreKeeper.GetScore();
+    result.maxCombo = scoreKeeper.GetMaxCombo();
+    result.perfectCount = scoreKeeper.GetPerfectCount();
+    result.goodCount = scoreKeeper.GetGoodCount();
+    result.fairCount = scoreKeeper.GetFairCount();
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ReadReplayFile(std::string const& replayFilePath, ReplayData& outReplay)
+{
+    MappedFile file;
+    if (!file.Open(replayFilePath.c_str()) || file.GetSize() < sizeof(ReplayFileHeader)) {
+        return false;
+    }
+
+    ReplayFileHeader header;
+    memcpy(&header, file.GetData(), sizeof(ReplayFileHeader));
+    if (header.magic != REPLAY_FILE_MAGIC || header.version != REPLAY_FILE_VERSION ||
+        header.recordSize != sizeof(ReplayRecord)) {
+        return false;
+    }
+
+    size_t expectedSize = sizeof(ReplayFileHeader) + (size_t)header.recordCount * sizeof(ReplayRecord);
+    if (file.GetSize() < expectedSize) {
+        return false;
+    }
+
+    outReplay.header = header;
+    outReplay.records.resize(header.recordCount);
+    if (header.recordCount > 0) {
+        memcpy(outReplay.records.data(), file.GetData() + sizeof(ReplayFileHeader), header.recordCount * sizeof(ReplayRecord));
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool WriteReplayFile(std::string const& replayFilePath, ReplayData const& replay)
+{
+    ReplayFileHeader header = replay.header;
+    header.recordSize = (uint16_t)sizeof(ReplayRecord);
+    header.recordCount = (uint32_t)replay.records.size();
+
+    std::ofstream file(replayFilePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write((char const*)&header, sizeof(ReplayFileHeader));
+    if (!replay.records.empty()) {
+        file.write((char const*)replay.records.data(), (std::streamsize)(replay.records.size() * sizeof(ReplayRecord)));
+    }
+    return file.good();
+}
+
+//////////////////////////////////////////////////////////////////////////
+//recorded inputs handed to the ticker at the tick they were judged in
+class ReplayInputSource : public GameplayInputSource
+{
+public:
+    void Push(GameplayInputEvent const& input, uint32_t dispatchMS);
+    bool PopInput(uint32_t untilMS, GameplayInputEvent& outInput) override;
+    void Flush(SongTimeline& timeline);    //whatever is left goes in now
+
+private:
+    std::vector<GameplayInputEvent> m_inputs;
+    std::vector<uint32_t> m_dispatchMS;
+    size_t m_nextInput = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayInputSource::Push(GameplayInputEvent const& input, uint32_t dispatchMS)
+{
+    m_inputs.push_back(input);
+    m_dispatchMS.push_back(dispatchMS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ReplayInputSource::PopInput(uint32_t untilMS, GameplayInputEvent& outInput)
+{
+    if (m_nextInput >= m_inputs.size() || m_dispatchMS[m_nextInput] > untilMS) {
+        return false;
+    }
+    outInput = m_inputs[m_nextInput++];
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ReplayInputSource::Flush(SongTimeline& timeline)
+{
+    for (; m_nextInput < m_inputs.size(); m_nextInput++) {
+        timeline.PushInput(m_inputs[m_nextInput]);
+    }
+    timeline.DispatchInput();
+    m_inputs.clear();
+    m_dispatchMS.clear();
+    m_nextInput = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ReplayResult PlayReplay(SongTimeline& timeline, ReplayData const& replay)
+{
+    timeline.SetPressDelayMS(replay.header.pressDelayMS);
+    timeline.BeginPlay();
+
+    GameplayTicker ticker;
+    ticker.SetTickMS(replay.header.tickMS);
+    ticker.Reset(0);
+
+    //inputs wait for the advance they were judged before, a seek or a plain advance takes all that are waiting
+    ReplayInputSource input;
+    for (ReplayRecord const& record : replay.records) {
+        switch (record.type) {
+        case REPLAY_RECORD_BUTTON_PRESSED:
+        case REPLAY_RECORD_STICK_MOVED: {
+            GameplayInputEvent event;
+            event.type = record.type == REPLAY_RECORD_BUTTON_PRESSED ? GAMEPLAY_INPUT_BUTTON_PRESSED : GAMEPLAY_INPUT_STICK_MOVED;
+            event.isLeft = record.isLeft != 0;
+            event.yValue = record.yValue;
+            event.timeMS = record.timeMS;
+            input.Push(event, record.dispatchMS);
+            break;
+        }
+        case REPLAY_RECORD_ADVANCE:
+            input.Flush(timeline);
+            timeline.AdvanceTo(record.timeMS);
+            break;
+        case REPLAY_RECORD_SEEK:
+            input.Flush(timeline);
+            timeline.Seek(record.timeMS);
+            ticker.Reset(record.timeMS);
+            break;
+        case REPLAY_RECORD_TICK_TO:
+            ticker.TickTo(timeline, record.timeMS, input);
+            break;
+        default:
+            break;
+        }
+    }
+
+    input.Flush(timeline);
+    timeline.EndPlay();
+    return GetReplayResult(timeline.GetScoreKeeper());
+}
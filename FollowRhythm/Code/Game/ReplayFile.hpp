@@ -0,0 +1,101 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct GameplayInputEvent;
+class SongTimeline;
+class ScoreKeeper;
+
+//replay: header followed by the exact stream of timeline calls of one play session
+//inputs are kept in dispatch order with the advance they were judged before, so playback is bit exact
+//a ticked session keeps one record per frame target and playback runs the same ticks again
+constexpr uint32_t REPLAY_FILE_MAGIC = 0x50525246;  //"FRRP" little endian
+constexpr uint16_t REPLAY_FILE_VERSION = 2;
+constexpr uint32_t REPLAY_DISPATCH_PENDING = 0xFFFFFFFF;    //no advance after the input yet
+
+enum eReplayRecordType : uint8_t
+{
+    REPLAY_RECORD_BUTTON_PRESSED = 0,
+    REPLAY_RECORD_STICK_MOVED,
+    REPLAY_RECORD_ADVANCE,
+    REPLAY_RECORD_SEEK,
+    REPLAY_RECORD_TICK_TO,      //GameplayTicker::TickTo of one frame
+};
+
+struct ReplayResult
+{
+    int32_t  score = 0;
+    uint32_t maxCombo = 0;
+    uint32_t perfectCount = 0;
+    uint32_t goodCount = 0;
+    uint32_t fairCount = 0;
+
+    bool operator==(ReplayResult const& other) const;
+};
+
+struct ReplayFileHeader
+{
+    uint32_t magic = REPLAY_FILE_MAGIC;
+    uint16_t version = REPLAY_FILE_VERSION;
+    uint16_t recordSize = 0;
+    uint32_t recordCount = 0;
+    uint32_t noteCount = 0;
+    uint64_t chartHash = 0;
+    float    pressDelayMS = 0.f;
+    ReplayResult result;        //what the recorded session ended with
+    uint32_t tickMS = 0;        //gameplay tick length, 0 if nothing was ticked
+    uint32_t padding = 0;
+};
+
+struct ReplayRecord
+{
+    uint32_t timeMS = 0;
+    uint32_t dispatchMS = REPLAY_DISPATCH_PENDING;  //inputs only, the advance they were judged before
+    float    yValue = 0.f;      //stick only
+    uint8_t  type = 0;          //eReplayRecordType
+    uint8_t  isLeft = 0;
+    uint8_t  padding[2] = {0,0};
+};
+
+static_assert(sizeof(ReplayFileHeader) == 56, "replay header layout changed, bump REPLAY_FILE_VERSION");
+static_assert(sizeof(ReplayRecord) == 16, "replay record layout changed, bump REPLAY_FILE_VERSION");
+
+struct ReplayData
+{
+    ReplayFileHeader header;
+    std::vector<ReplayRecord> records;
+};
+
+//attached to a SongTimeline, sees every call that changes the play state
+class ReplayRecorder
+{
+public:
+    void Begin(uint32_t noteCount, uint64_t chartHash, float pressDelayMS);
+    void RecordInput(GameplayInputEvent const& input);
+    void RecordAdvance(uint32_t timeMS);
+    void RecordSeek(uint32_t timeMS);
+    void BeginTicks(uint32_t tickMS);       //advances until EndTicks are ticks, only the frame target is kept
+    void EndTicks(uint32_t targetMS);
+    void End(ScoreKeeper const& scoreKeeper);
+
+    bool              IsRecording() const { return m_isRecording; }
+    ReplayData const& GetReplay() const   { return m_replay; }
+
+private:
+    void SetPendingDispatchMS(uint32_t timeMS);
+
+private:
+    ReplayData m_replay;
+    size_t m_firstPendingRecord = 0;
+    bool m_isRecording = false;
+    bool m_isTicking = false;
+};
+
+ReplayResult GetReplayResult(ScoreKeeper const& scoreKeeper);
+bool         ReadReplayFile(std::string const& replayFilePath, ReplayData& outReplay);
+bool         WriteReplayFile(std::string const& replayFilePath, ReplayData const& replay);
+
+//feeds the records through the timeline on their recorded clock, returns the result it ends with
+ReplayResult PlayReplay(SongTimeline& timeline, ReplayData const& replay);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+//lock free ring for one producer thread and one consumer thread
+//CAPACITY must be a power of two, one slot is always left empty
+template<typename T, size_t CAPACITY>
+class SPSCQueue
+{
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+public:
+    bool Push(T const& item);   //producer only, false when full
+    bool Pop(T& outItem);       //consumer only, false when empty
+    bool IsEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+private:
+    T m_items[CAPACITY];
+    alignas(64) std::atomic<size_t> m_head{ 0 };    //next slot to pop
+    alignas(64) std::atomic<size_t> m_tail{ 0 };    //next slot to push
+};
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, size_t CAPACITY>
+bool SPSCQueue<T, CAPACITY>::Push(T const& item)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t nextTail = (tail + 1) & (CAPACITY - 1);
+    if (nextTail == m_head.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    m_items[tail] = item;
+    m_tail.store(nextTail, std::memory_order_release);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template<typename T, size_t CAPACITY>
+bool SPSCQueue<T, CAPACITY>::Pop(T& outItem)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    outItem = m_items[head];
+    m_head.store((head + 1) & (CAPACITY - 1), std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,137 @@
+#include "Game/ScoreKeeper.hpp"
+#include "Game/JudgementEngine.hpp"
+#include "Game/GameplayConstants.hpp"
+#include "Game/NoteTable.hpp"
+#include <algorithm>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+float GetScoreMultiplierFromComboCount(unsigned int comboCount)
+{
+    float multiplier = (float)comboCount / (float)COMBO_SINGLE_RATE_COUNT;
+    return multiplier < 1.f ? 1.f : (multiplier > COMBO_MAX_RATE ? COMBO_MAX_RATE : multiplier);
+}
+
+//////////////////////////////////////////////////////////////////////////
+eScoreGrade ScoreKeeper::GetGradeForRank(float rank)
+{
+    if (rank >= COMBO_PERFECT_RANK) {
+        return SCORE_GRADE_PERFECT;
+    }
+    if (rank >= COMBO_GOOD_RANK) {
+        return SCORE_GRADE_GOOD;
+    }
+    if (rank >= COMBO_FAIR_RANK) {
+        return SCORE_GRADE_FAIR;
+    }
+    return SCORE_GRADE_MISS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+char const* ScoreKeeper::GetGradeName(eScoreGrade grade)
+{
+    switch (grade) {
+    case SCORE_GRADE_PERFECT:   return "Perfect";
+    case SCORE_GRADE_GOOD:      return "Good";
+    case SCORE_GRADE_FAIR:      return "OK";
+    default:                    return "MISS";
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+int ScoreKeeper::GetPerfectScore(NoteTable const& table)
+{
+    //singles score when pressed at their start, holds when they leave the screen
+    //within the same ms inputs are judged before notes retire, same as a frame
+    struct ScoringPoint
+    {
+        uint32_t timeMS;
+        uint32_t isHold;
+        uint32_t noteIndex;
+        float    rank;
+    };
+    std::vector<ScoringPoint> points(table.count);
+    uint32_t lastHold[2] = { UINT32_MAX, UINT32_MAX };
+    for (uint32_t i = 0; i < table.count; i++) {
+        bool isHold = table.IsHold(i);
+        points[i] = { isHold ? table.renderEndMS[i] : table.startMS[i], isHold ? 1u : 0u, i, 100.f };
+        if (!isHold) {
+            continue;
+        }
+
+        //one stick cannot hold two notes, a hold running into the next one on its side is cut short
+        uint32_t& previous = lastHold[table.IsLeft(i) ? 0 : 1];
+        if (previous != UINT32_MAX) {
+            uint32_t previousEnd = table.startMS[previous] + table.duration[previous];
+            if (previousEnd > table.startMS[i]) {
+                uint32_t heldMS = table.startMS[i] - table.startMS[previous];
+                points[previous].rank = JudgementEngine::GetHoldRank(heldMS, table.duration[previous]);
+            }
+        }
+        previous = i;
+    }
+    std::sort(points.begin(), points.end(), [](ScoringPoint const& a, ScoringPoint const& b) {
+        if (a.timeMS != b.timeMS) {
+            return a.timeMS < b.timeMS;
+        }
+        return a.isHold != b.isHold ? a.isHold < b.isHold : a.noteIndex < b.noteIndex;
+    });
+
+    ScoreKeeper perfect;
+    for (ScoringPoint const& point : points) {
+        Judgement judgement;
+        judgement.type = point.isHold ? JUDGEMENT_HOLD_SCORED : JUDGEMENT_SINGLE_HIT;
+        judgement.noteIndex = point.noteIndex;
+        judgement.rank = point.rank;
+        judgement.multiplier = point.isHold ? JudgementEngine::GetHoldMultiplier(table.duration[point.noteIndex]) : 1.f;
+        perfect.AddScore(judgement);
+    }
+    return perfect.GetScore();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ScoreKeeper::Reset()
+{
+    *this = ScoreKeeper();
+}
+
+//////////////////////////////////////////////////////////////////////////
+eScoreGrade ScoreKeeper::AddScore(Judgement const& judgement)
+{
+    float rank = judgement.rank;
+    eScoreGrade grade = GetGradeForRank(rank);
+    if (grade >= SCORE_GRADE_GOOD) {
+        if (grade == SCORE_GRADE_PERFECT) {
+            m_perfectCount++;
+        }
+        else {
+            m_goodCount++;
+        }
+        m_comboCount++;
+        rank *= GetScoreMultiplierFromComboCount(m_comboCount);
+    }
+    else {
+        BreakCombo();
+        if (grade == SCORE_GRADE_FAIR) {
+            m_fairCount++;
+        }
+    }
+
+    rank *= judgement.multiplier;
+    m_score += (int)rank;
+    return grade;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ScoreKeeper::BreakCombo()
+{
+    m_maxCombo = m_maxCombo > m_comboCount ? m_maxCombo : m_comboCount;
+    m_comboCount = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+unsigned int ScoreKeeper::GetMissCount(unsigned int noteCount) const
+{
+    unsigned int hitCount = m_perfectCount + m_goodCount + m_fairCount;
+    return noteCount > hitCount ? noteCount - hitCount : 0;
+}
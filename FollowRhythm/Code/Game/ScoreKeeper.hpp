@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+struct Judgement;
+struct NoteTable;
+
+enum eScoreGrade : uint8_t
+{
+    SCORE_GRADE_MISS = 0,
+    SCORE_GRADE_FAIR,
+    SCORE_GRADE_GOOD,
+    SCORE_GRADE_PERFECT,
+};
+
+float GetScoreMultiplierFromComboCount(unsigned int comboCount);
+
+//score, combo and grade counts of one play session
+class ScoreKeeper
+{
+public:
+    static eScoreGrade GetGradeForRank(float rank);
+    static char const* GetGradeName(eScoreGrade grade);
+    static int         GetPerfectScore(NoteTable const& table);    //best playable run in the order notes score
+
+    void        Reset();
+    eScoreGrade AddScore(Judgement const& judgement);   //only for scored judgements
+    void        BreakCombo();
+
+    int          GetScore() const        { return m_score; }
+    unsigned int GetComboCount() const   { return m_comboCount; }
+    unsigned int GetMaxCombo() const     { return m_maxCombo; }
+    unsigned int GetPerfectCount() const { return m_perfectCount; }
+    unsigned int GetGoodCount() const    { return m_goodCount; }
+    unsigned int GetFairCount() const    { return m_fairCount; }
+    unsigned int GetMissCount(unsigned int noteCount) const;
+
+private:
+    int m_score = 0;
+    unsigned int m_comboCount = 0;
+    unsigned int m_maxCombo = 0;
+    unsigned int m_perfectCount = 0;
+    unsigned int m_goodCount = 0;
+    unsigned int m_fairCount = 0;
+};
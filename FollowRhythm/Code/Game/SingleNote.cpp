@@ -1,6 +1,7 @@
 #include "Game/SingleNote.hpp"
+#include "Game/NoteTable.hpp"
+#include "Game/JudgementEngine.hpp"
 #include "Game/GameCommon.hpp"
-#include "Game/Song.hpp"
 #include "Game/Game.hpp"
 #include "Game/Effects.hpp"
 #include "Game/AssetManager.hpp"
@@ -8,10 +9,7 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/Timer.hpp"
-#include "Engine/Renderer/SpriteAnimDefinition.hpp"
-#include "Engine/Renderer/SpriteDefinition.hpp"
-
-#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
 
 static float sNoteRenderMaxTime = (float)NOTE_RENDER_MAX_TIME_MS*.001f;
 static float sNoteHitPosY = 0.f;
@@ -19,28 +17,11 @@ static float sNoteHitPosLeftX = 0.f;
 static float sNoteHitPosRightX = 0.f;
 
 //////////////////////////////////////////////////////////////////////////
-SingleNote::SingleNote(Song* song, bool isLeft, unsigned int startMS)
-    : Note(song, NOTE_SINGLE, isLeft, startMS)
-{
-}
-
-//////////////////////////////////////////////////////////////////////////
-void SingleNote::StartToSee()
-{
-    g_theEvents->RegisterMethodEvent("ButtonPressed", this, &SingleNote::HandleButtonPressed, "LB/RB pressed", EVENT_GAME);
-}
-
-//////////////////////////////////////////////////////////////////////////
-void SingleNote::EndToSee()
-{
-    m_isHit = false;
-    g_theEvents->UnsubscribeObject(this);
-}
-
-//////////////////////////////////////////////////////////////////////////
-void SingleNote::Render(AABB2 const& bounds) const
+void AppendVertsForSingleNote(std::vector<Vertex_PCU>& verts, NoteTable const& table, size_t noteIndex, uint32_t elapsedMS,
+    AABB2 const& bounds)
 {    
-    float rawAge = m_song->GetNoteAgeFromTimeMS(m_startMS);
+    bool isLeft = table.IsLeft(noteIndex);
+    float rawAge = GetNoteAgeAtTimeMS(table.startMS[noteIndex], elapsedMS);
     float minX = bounds.mins.x;
     float maxX = bounds.maxs.x;
     float age = ClampZeroToOne(rawAge);
@@ -49,95 +30,50 @@ void SingleNote::Render(AABB2 const& bounds) const
     sNoteHitPosLeftX = minX+halfXValue;
     sNoteHitPosY = Interpolate(bounds.mins.y, bounds.maxs.y, .65f);
     Vec2 anchor(xPos + minX, sNoteHitPosY);
-    if (!m_isLeft) {    //right half
+    if (!isLeft) {    //right half
         anchor.x = maxX - xPos;
         sNoteHitPosRightX = maxX-halfXValue;
     }    
 
     float renderFraction = 15.f*NOTE_RENDER_HALF_SIZE;    
-    Vec2 uvMins, uvMaxs;
+    Vec2 halfDim(renderFraction * .5f, renderFraction * .5f);
+    AABB2 noteBounds(anchor - halfDim, anchor + halfDim);
+    AssetManager const* assets = AssetManager::gAssetManager;
+    SpriteUVs const* uvs = nullptr;
     if (rawAge < NOTE_RENDER_ATTACK_START_AGE) {    //fly
-        SpriteDefinition const& def = AssetManager::gAssetManager->m_singleMonsterAnim->GetSpriteDefAtTime(rawAge * 5.f);
-        def.GetUVs(uvMins, uvMaxs);
+        uvs = &assets->m_singleMonsterUVs.GetUVsAtTime(rawAge * 5.f, !isLeft);
     }
     else if (rawAge < 1.f) {    //attack
-        SpriteDefinition const& def = AssetManager::gAssetManager->m_singleAttackAnim->GetSpriteDefAtTime((rawAge- NOTE_RENDER_ATTACK_START_AGE)*sNoteRenderMaxTime);
-        def.GetUVs(uvMins, uvMaxs);
+        uvs = &assets->m_singleAttackUVs.GetUVsAtTime((rawAge - NOTE_RENDER_ATTACK_START_AGE) * sNoteRenderMaxTime, !isLeft);
     }
     else {  //finish
-        SpriteDefinition const& def = AssetManager::gAssetManager->m_singleFinishAnim->GetSpriteDefAtTime((rawAge - 1.f)*sNoteRenderMaxTime*2.f);
-        def.GetUVs(uvMins, uvMaxs);
-    }
-    if (!m_isLeft) {
-        SwapFloat(uvMins.x, uvMaxs.x);
+        uvs = &assets->m_singleFinishUVs.GetUVsAtTime((rawAge - 1.f) * sNoteRenderMaxTime * 2.f, !isLeft);
     }
+    Vec2 const& uvMins = uvs->uvMins;
+    Vec2 const& uvMaxs = uvs->uvMaxs;
 
-    if(m_isHit){
+    if(table.IsScored(noteIndex)){
         if (rawAge > 1.f) {
             return;
         }
-        g_theRenderer->DrawSquare2D(anchor, renderFraction, Rgba8(150, 150, 150, 150),uvMins, uvMaxs);
+        AppendVertsForAABB2D(verts, noteBounds, uvMins, uvMaxs, Rgba8(150, 150, 150, 150));
         return;
     }
     
     Rgba8 drawColor = Rgba8::RED;
     if (rawAge > 1.f) {
         drawColor = Lerp(Rgba8(0,0,0,0), Rgba8::RED, (rawAge-1.f)/NOTE_RENDER_FINISH_AGE);
-        g_theRenderer->DrawSquare2D(anchor, renderFraction, drawColor, uvMins, uvMaxs);
+        AppendVertsForAABB2D(verts, noteBounds, uvMins, uvMaxs, drawColor);
         return;
     }
     
-    g_theRenderer->DrawSquare2D(anchor, renderFraction, Rgba8::WHITE, uvMins, uvMaxs);    
-}
-
-//////////////////////////////////////////////////////////////////////////
-unsigned int SingleNote::GetRenderBeginMS() const
-{
-    if (m_startMS < NOTE_RENDER_MAX_TIME_MS) {
-        return 0;
-    }
-
-    return m_startMS - NOTE_RENDER_MAX_TIME_MS;
+    AppendVertsForAABB2D(verts, noteBounds, uvMins, uvMaxs, Rgba8::WHITE);
 }
 
 //////////////////////////////////////////////////////////////////////////
-unsigned int SingleNote::GetRenderEndMS() const
+void PlaySingleNoteHitEffect(NoteTable const& table, Judgement const& judgement)
 {
-    return m_startMS + NOTE_SCORE_DELTA_TIME_MS;
-}
-
-//////////////////////////////////////////////////////////////////////////
-bool SingleNote::IsScored() const
-{
-    return m_isHit;
-}
-
-//////////////////////////////////////////////////////////////////////////
-bool SingleNote::HandleButtonPressed(EventArgs& args)
-{
-    if (m_isHit) {
-        return false;
-    }
-
-    bool isLeft = args.GetValue("isLeft", true);
-    if (m_isLeft == isLeft) {
-        float elapsedMS = (float)m_song->GetSongElapsedMS();
-        float delta = (elapsedMS - (float)m_startMS);
-        float score = AbsFloat(delta - gNoteDelayDelta) / (float)NOTE_SCORE_DELTA_TIME_MS;
-        if (score >= 1.f) {
-            return false;
-        }
-        else {
-            m_isHit = true;
-            score = 1.f-score;
-            float rank = (score*100.f);
-            float noteHitPosX = m_isLeft? sNoteHitPosLeftX:sNoteHitPosRightX;
-            PlayParticleEffectForSingle(rank, Vec2(noteHitPosX, sNoteHitPosY), m_isLeft);
-            g_theEvents->FireEvent(Stringf("AddScore rank=%f delta=%f", rank, delta), EVENT_GAME);
-            return true;
-        }
-    }
-    else {
-        return false;
-    }
+    bool isNoteLeft = table.IsLeft(judgement.noteIndex);
+    float noteHitPosX = isNoteLeft? sNoteHitPosLeftX:sNoteHitPosRightX;
+    PlayParticleEffectForSingle(judgement.rank, Vec2(noteHitPosX, sNoteHitPosY), isNoteLeft);
 }
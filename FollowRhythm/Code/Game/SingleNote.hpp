@@ -1,24 +1,15 @@
 #pragma once
 
-#include "Game/Note.hpp"
-#include "Engine/Core/EventSystem.hpp"
-
-class SingleNote : public Note
-{
-public:
-    SingleNote(Song* song, bool isLeft, unsigned int startTimeSeconds);
-    ~SingleNote() = default;
-
-    void StartToSee() override;
-    void EndToSee() override;
-    void Render(AABB2 const& bounds) const override;
-
-    unsigned int GetRenderBeginMS() const override;
-    unsigned int GetRenderEndMS() const override;
-    bool IsScored() const override;
-
-    bool HandleButtonPressed(EventArgs& args);
-
-private:
-    bool m_isHit = false;
-};
\ No newline at end of file
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct AABB2;
+struct NoteTable;
+struct Judgement;
+struct Vertex_PCU;
+
+//single notes are rows of NoteTable with zero duration
+void AppendVertsForSingleNote(std::vector<Vertex_PCU>& verts, NoteTable const& table, size_t noteIndex, uint32_t elapsedMS,
+    AABB2 const& bounds);   //monster sheet uvs
+void PlaySingleNoteHitEffect(NoteTable const& table, Judgement const& judgement);
\ No newline at end of file
@@ -1,8 +1,14 @@
 #include "Game/Song.hpp"
-#include "Game/Note.hpp"
+#include "Game/SingleNote.hpp"
+#include "Game/MultiNotes.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/FrameVertexArena.hpp"
 #include "Game/SongManager.hpp"
 #include "Game/AssetManager.hpp"
+#include "Game/ChartFile.hpp"
+#include "Game/ChartParser.hpp"
+#include "Game/InputSampler.hpp"
+#include "Game/GameAudioSystem.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/FileUtils.hpp"
@@ -10,24 +16,60 @@
 #include "Engine/Core/XMLUtils.hpp"
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/Image.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/MathUtils.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
+#include "ThirdParty/fmod/fmod.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Input/InputSystem.hpp"
 
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include <filesystem>
+#include <mutex>
 
 static float sTotalCalibDelta = 0.f;
 static unsigned int sTotalCalibHit = 0;
 static float sLeftStickMoveValue = (NOTE_RENDER_MULTI_DOWN_Y + NOTE_RENDER_MULTI_UP_Y) * .5f;
 static float sRightStickMoveValue = (NOTE_RENDER_MULTI_DOWN_Y + NOTE_RENDER_MULTI_UP_Y) * .5f;
 static float sInstantRank = 0.f;
+static bool sIsAutoplay = false;
+static float sAutoplayErrorMS = 0.f;
+static uint32_t sGameplayTickRate = GAMEPLAY_DEFAULT_TICK_RATE;
 
 static Background sBackground;
 static FireFlicker sFireFlicker(nullptr, Rgba8::WHITE);
+static std::mutex sLoadErrorMutex;
+static const double sSongStartLeadSeconds = .1;    //far enough ahead that the mixer has not passed it yet
+
+//////////////////////////////////////////////////////////////////////////
+static bool IsChartFileUpToDate(std::string const& chartFile, std::string const& notesFile)
+{
+    std::error_code error;
+    std::filesystem::file_time_type chartTime = std::filesystem::last_write_time(chartFile, error);
+    if (error) {
+        return false;
+    }
+    std::filesystem::file_time_type notesTime = std::filesystem::last_write_time(notesFile, error);
+    if (error) {    //compiled chart shipped without its source
+        return true;
+    }
+    return chartTime >= notesTime;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::SetAutoplay(bool isEnabled, float errorStdDevMS)
+{
+    sIsAutoplay = isEnabled;
+    sAutoplayErrorMS = errorStdDevMS < 0.f ? 0.f : errorStdDevMS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::SetGameplayTickRate(int ticksPerSecond)
+{
+    sGameplayTickRate = ticksPerSecond < 1 ? 1 : (uint32_t)ticksPerSecond;
+}
 
 //////////////////////////////////////////////////////////////////////////
 float Song::GetAverageCalibrationDeltaTime()
@@ -40,28 +82,64 @@ float Song::GetAverageCalibrationDeltaTime()
 }
 
 //////////////////////////////////////////////////////////////////////////
-Song::Song(char const* songName)
+bool Song::CompileNotesFile(std::string const& songFilePath)
+{
+    std::string notesFile = GetNotesFilePath(songFilePath);
+    std::vector<ChartNoteRecord> records;
+    std::vector<ChartParseError> errors;
+    if (!ReadNotesCSVFile(notesFile, records, errors)) {
+        return false;
+    }
+
+    for (ChartParseError const& error : errors) {
+        g_theConsole->PrintString(Rgba8::RED, Stringf("%s(%u): %s", notesFile.c_str(), error.lineNumber, error.message.c_str()));
+    }
+
+    return WriteChartFile(GetChartFilePath(songFilePath), records);
+}
+
+//////////////////////////////////////////////////////////////////////////
+Song::Song(char const* songFilePath)
+    : m_soundFilePath(songFilePath)
 {
-    m_songPath = GetMusicPathWithoutEXT(songName);
-    m_soundID = g_theAudio->CreateOrGetSound(songName);
+    m_songPath = GetMusicPathWithoutEXT(songFilePath);
     
     Strings names = SplitStringOnDelimiter(m_songPath, '/');
     m_isCalibration = (names.back() == "Calibration");
+}
 
-    LoadInfoFile();
-    LoadNotesFile();
+//////////////////////////////////////////////////////////////////////////
+Song::~Song()
+{
+    UnloadNotes();
+}
 
-    sBackground = AssetManager::gAssetManager->GetRandomBackgroundPaths();
-    sFireFlicker = AssetManager::gAssetManager->GetRandomFireFlicker();
+//////////////////////////////////////////////////////////////////////////
+bool Song::LoadNotes()
+{
+    if (m_areNotesLoaded) {
+        return true;
+    }
+    if (!m_isValid) {
+        return false;
+    }
+
+    LoadNotesFile();
+    PrintLoadErrors();
+    m_areNotesLoaded = m_isValid;
+    return m_areNotesLoaded;
 }
 
 //////////////////////////////////////////////////////////////////////////
-Song::~Song()
+void Song::UnloadNotes()
 {
-    for (Note* n : m_notes) {
-        delete n;
+    if (m_isPlaying) {
+        ERROR_RECOVERABLE(Stringf("Unload notes of %s while playing", m_songName.c_str()));
+        return;
     }
-    m_notes.clear();
+
+    m_timeline.Release();
+    m_areNotesLoaded = false;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -71,30 +149,37 @@ void Song::UpdateForCurrentNotes()
         return;
     }
 
-    //clean out outdated current notes
-    for (auto iter = m_currentNotesIndex.begin(); iter!=m_currentNotesIndex.end();) {
-        Note* note = m_notes[*iter];
-        if (note->IsGarbage()) {
-            if (!note->IsScored()) {
-                UpdateCombo();
-            }
-            note->EndToSee();
-            m_currentNotesIndex.erase(iter);
-            iter = m_currentNotesIndex.begin();
-        }
-        else {
-            iter++;
-        }
+    //catch up to the song clock tick by tick, a long frame runs more ticks
+    GameplayInputSource& input = m_isAutoplaying ? (GameplayInputSource&)m_autoplay : m_sampledInput;
+    m_ticker.TickTo(m_timeline, m_elapsedMS, input);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::UpdateForSampledInput(InputSampler& sampler)
+{
+    m_isInputSampled = sampler.IsRunning();
+    if (m_isPaused) {
+        sampler.DiscardEvents();
+        return;
     }
 
-    //push in new current notes
-    m_endNoteIndex = m_currentNotesIndex.empty()?m_endNoteIndex:m_currentNotesIndex.back()+1;
-    for (size_t i = m_endNoteIndex; i < m_notes.size(); i++) {
-        Note* note = m_notes[i];
-        if (note->IsNew()) {
-            note->StartToSee();
-            m_currentNotesIndex.push_back((unsigned int)i);
-        }
+    if (m_isAutoplaying) {
+        sampler.DiscardEvents();
+        return;
+    }
+
+    //sampler timestamps share the song clock's host clock
+    SampledInputEvent sampled;
+    while (sampler.PopEvent(sampled)) {
+        double timeMS = m_songClock.GetTimeMSAt(sampled.timeSeconds);
+        timeMS = timeMS < 0.0 ? 0.0 : (timeMS > (double)m_elapsedMS ? (double)m_elapsedMS : timeMS);
+
+        GameplayInputEvent input;
+        input.type = sampled.type;
+        input.isLeft = sampled.isLeft;
+        input.yValue = sampled.yValue;
+        input.timeMS = (unsigned int)(timeMS + .5);
+        m_sampledInput.Push(input);
     }
 }
 
@@ -105,7 +190,7 @@ void Song::UpdateForPlayInput()
     sLeftStickMoveValue = defaultY;
     sRightStickMoveValue = defaultY;
 
-    if (m_isPaused) {
+    if (m_isPaused || m_isAutoplaying) {
         return;
     }
 
@@ -114,41 +199,61 @@ void Song::UpdateForPlayInput()
         return;
     }
 
-    if (controller.GetButtonState(XBOX_BUTTON_ID_LSHOULDER).WasJustPressed()) { //left single
-        g_theEvents->FireEvent("ButtonPressed isLeft=true", EVENT_GAME);
+    //typed events straight into the queue, no string formatting or parsing per frame
+    //stamped with the last tick, frame input is never judged ahead of the notes
+    GameplayInputEvent press;
+    press.type = GAMEPLAY_INPUT_BUTTON_PRESSED;
+    press.timeMS = m_timeline.GetElapsedMS();
+    if (!m_isInputSampled && controller.GetButtonState(XBOX_BUTTON_ID_LSHOULDER).WasJustPressed()) { //left single
+        press.isLeft = true;
+        m_timeline.PushInput(press);
     }
-    if (controller.GetButtonState(XBOX_BUTTON_ID_RSHOULDER).WasJustPressed()) { //right single
-        g_theEvents->FireEvent("ButtonPressed isLeft=false", EVENT_GAME);
+    if (!m_isInputSampled && controller.GetButtonState(XBOX_BUTTON_ID_RSHOULDER).WasJustPressed()) { //right single
+        press.isLeft = false;
+        m_timeline.PushInput(press);
     }    
     
+    //the frame stick always drives the joystick blocks, holds only see it when nothing is sampled
+    //a frame poll is older than the sampler's edges and would undo them
+    GameplayInputEvent move;
+    move.type = GAMEPLAY_INPUT_STICK_MOVED;
+    move.timeMS = m_timeline.GetElapsedMS();
     AnalogJoystick const& lJoystick = controller.GetLeftJoystick();
     float lStickYValue = lJoystick.GetPosition().y;
-    std::string text = Stringf("JoystickMoved isLeft=true yValue=%f", lStickYValue);    
     if (lStickYValue > INPUT_JOYSTICK_DEAD_Y) {
         sLeftStickMoveValue = NOTE_RENDER_MULTI_UP_Y;
     }
     else if (lStickYValue < -INPUT_JOYSTICK_DEAD_Y) {
         sLeftStickMoveValue = NOTE_RENDER_MULTI_DOWN_Y;
     }
-    g_theEvents->FireEvent(text, EVENT_GAME);
+    if (!m_isInputSampled) {
+        move.isLeft = true;
+        move.yValue = lStickYValue;
+        m_timeline.PushInput(move);
+    }
 
     AnalogJoystick const& rJoystick = controller.GetRightJoystick();
     float rStickYValue = rJoystick.GetPosition().y;
-    text = Stringf("JoystickMoved isLeft=false yValue=%f", rStickYValue);    
     if (rStickYValue > INPUT_JOYSTICK_DEAD_Y) {
         sRightStickMoveValue = NOTE_RENDER_MULTI_UP_Y;
     }
     else if (rStickYValue < -INPUT_JOYSTICK_DEAD_Y) {
         sRightStickMoveValue = NOTE_RENDER_MULTI_DOWN_Y;
     }
-    g_theEvents->FireEvent(text, EVENT_GAME);
+    if (!m_isInputSampled) {
+        move.isLeft = false;
+        move.yValue = rStickYValue;
+        m_timeline.PushInput(move);
+    }
+
+    m_timeline.DispatchInput();
 }
 
 //////////////////////////////////////////////////////////////////////////
 void Song::Render(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const
 {
     if (!m_isCalibration) { //background
-        g_theRenderer->BindDiffuseTexture(sBackground.mainBG.c_str());
+        BindTexture(sBackground.mainTexture);
         g_theRenderer->DrawAABB2D(bounds, Rgba8(150,150,150));
     }
     
@@ -159,14 +264,14 @@ void Song::Render(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const
     //center
     float halfWidth = RENDER_CENTER_FRACTION * (bounds.maxs.x-bounds.mins.x) *.5f;
     AABB2 centerBound(-halfWidth, bounds.mins.y, halfWidth, bounds.maxs.y);
-    g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+    BindTexture(nullptr);
     g_theRenderer->DrawAABB2D(centerBound, flickerColor);
 
     if (!m_isCalibration) { 
          //base
         float baseWidth = 1.6f * halfWidth;
         Vec2 baseDim(baseWidth, baseWidth);
-        g_theRenderer->BindDiffuseTexture("data/images/base.png");
+        BindTexture(AssetManager::gAssetManager->GetTexture(TEXTURE_BASE));
         AABB2 baseBound = centerBound.GetBoxAtBottom(0.f, baseWidth);
         baseBound.SetDimensions(baseDim);
         Rgba8 baseColor = Lerp(flickerColor, Rgba8(255,255,255,alphaFlicker), bgFlickerFactor);
@@ -183,27 +288,27 @@ void Song::Render(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const
         g_theRenderer->DrawAABB2D(rightBlock, Rgba8::GREEN, Vec2(0.f, 1.f), Vec2(1.f, 0.f));
 
         //fire
-        Vec2 uvMins, uvMaxs;
-        AssetManager::gAssetManager->GetFireFlickerUVsAtTime(uvMins, uvMaxs, m_elapsedMS);        
+        SpriteUVs const& fireUVs = AssetManager::gAssetManager->GetFireFlickerUVsAtTime(GetRenderTimeMS());
         AABB2 fireBounds = centerBound.GetBoxAtBottom(0.f, baseWidth * 2.f);
         fireBounds.ChopBoxOffBottom(.5f);
         float dilationRate = Interpolate(1.f, 2.2f, bgFlickerFactor);
         fireBounds.SetDimensions(baseDim * dilationRate);
         fireBounds.Translate(Vec2(-5.f,0.f));
-        g_theRenderer->BindDiffuseTexture(sFireFlicker.texture);
-        g_theRenderer->DrawAABB2D(fireBounds, flickerColor, uvMins, uvMaxs);
+        BindTexture(sFireFlicker.texture);
+        g_theRenderer->DrawAABB2D(fireBounds, flickerColor, fireUVs.uvMins, fireUVs.uvMaxs);
 
         //HUD
         //progress bar
-        g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+        BindTexture(nullptr);
         AABB2 progressBar = bounds.GetBoxAtTop(.05f);
         g_theRenderer->DrawAABB2D(progressBar, Rgba8(100, 100, 100, 255));
         float progress = GetSongProgress();
         progressBar.ChopBoxOffRight(1.f - GetSongProgress());
-        g_theRenderer->BindDiffuseTexture("data/images/buttons-2d/progress.png");
+        BindTexture(AssetManager::gAssetManager->GetTexture(TEXTURE_PROGRESS));
         g_theRenderer->DrawAABB2D(progressBar, Rgba8::WHITE, Vec2::ZERO, Vec2(progress, 1.f));
 
         //combo
+        ScoreKeeper const& scoreKeeper = m_timeline.GetScoreKeeper();
         AABB2 ComboBound = bounds.GetBoxAtRight(.6f);
         ComboBound.ChopBoxOffRight(.6667f);
         ComboBound.ChopBoxOffTop(.1f);
@@ -212,92 +317,141 @@ void Song::Render(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const
         float textHeight = ComboBound.GetDimensions().y * .2f;
         AABB2 scoreBound = ComboBound.ChopBoxOffTop(.25f);
         AABB2 comboCountBound = ComboBound.ChopBoxOffBottom(.5f);
-        Rgba8 comboColor = Lerp(Rgba8(255,223,0),Rgba8::WHITE, GetScoreMultiplierFromComboCount(m_comboCount)*.2f );
+        Rgba8 comboColor = Lerp(Rgba8(255,223,0),Rgba8::WHITE, GetScoreMultiplierFromComboCount(scoreKeeper.GetComboCount())*.2f );
         g_theFont->AddVertsForTextInBox2D(textVerts, scoreBound, textHeight*dilationRate,
-            Stringf("%i", m_score), Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .1f, FONT_DEFAULT_KERNING);
+            Stringf("%i", scoreKeeper.GetScore()), Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .1f, FONT_DEFAULT_KERNING);
         g_theFont->AddVertsForTextInBox2D(textVerts, ComboBound, textHeight, "Combo",
             comboColor, FONT_DEFAULT_ASPECT, ALIGN_BOTTOM_CENTER, .1f, FONT_DEFAULT_KERNING);
         g_theFont->AddVertsForTextInBox2D(textVerts, comboCountBound, textHeight*dilationRate,
-            Stringf("%u", m_comboCount), comboColor, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .1f, FONT_DEFAULT_KERNING);
+            Stringf("%u", scoreKeeper.GetComboCount()), comboColor, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .1f, FONT_DEFAULT_KERNING);
     }    
 
-    //draw notes
-    g_theRenderer->BindDiffuseTexture(&AssetManager::gAssetManager->m_monsterSheet->GetTexture());
-    for (auto iter = m_currentNotesIndex.begin(); iter != m_currentNotesIndex.end(); iter++) {
-        m_notes[*iter]->Render(bounds);
-    }    
-}
-
-//////////////////////////////////////////////////////////////////////////
-bool Song::AddScore(EventArgs& args)
-{
-    float rank = args.GetValue("rank", 0.f);
-    sInstantRank = rank;
-    std::string debugText = Stringf("Rank: %.0f\n", rank); 
-    
-    if(rank>=COMBO_GOOD_RANK){
-        if (rank >= COMBO_PERFECT_RANK) {
-            m_perfectCount++;
-            debugText +="Perfect";
-        }
-        else {
-            m_goodCount++;
-            debugText += "Good";
+    //draw notes, every head and tail shares the monster sheet so they go out in one draw
+    uint32_t renderMS = GetRenderTimeMS();
+    NoteTable const& noteTable = m_timeline.GetNoteTable();
+    ActiveNoteWindow const& activeNotes = m_timeline.GetActiveNotes();
+    std::vector<Vertex_PCU>& noteVerts = g_theFrameVerts->Acquire();
+    for (size_t slot = 0; slot < activeNotes.GetSlotCount(); slot++) {
+        uint32_t noteIndex = activeNotes.GetNoteInSlot(slot);
+        if (noteIndex == ACTIVE_NOTE_TOMBSTONE) {
+            continue;
         }
-        m_comboCount++;
-        float multiplier = GetScoreMultiplierFromComboCount(m_comboCount);
-        rank*= multiplier;
-    }
-    else{
-        UpdateCombo();
-        if (rank >= COMBO_FAIR_RANK) {
-            debugText += "OK";            
-            m_fairCount++;
+        if (noteTable.IsHold(noteIndex)) {
+            AppendVertsForHoldNote(noteVerts, noteTable, noteIndex, renderMS, bounds);
         }
         else {
-            debugText += "MISS";
+            AppendVertsForSingleNote(noteVerts, noteTable, noteIndex, renderMS, bounds);
         }
     }
+    if (!noteVerts.empty()) {
+        BindTexture(&AssetManager::gAssetManager->m_monsterSheet->GetTexture());
+        g_theRenderer->DrawVertexArray(noteVerts);
+    }
+}
 
-    float multiFactor = args.GetValue("multi", 1.f);
-    rank *= multiFactor;
-    m_score += (int)rank;
+//////////////////////////////////////////////////////////////////////////
+void Song::OnJudgement(Judgement const& judgement)
+{
+    NoteTable& noteTable = m_timeline.GetNoteTable();
+    if (judgement.type == JUDGEMENT_SINGLE_HIT) {
+        PlaySingleNoteHitEffect(noteTable, judgement);
+    }
+    else {
+        UpdateHoldNoteEffect(noteTable, judgement);
+    }
+    if (!judgement.IsScored()) {
+        return;
+    }
 
+    //the timeline already scored it, this is only feedback
+    float rank = judgement.rank;
+    sInstantRank = rank;
+    std::string debugText = Stringf("Rank: %.0f\n%s", rank, ScoreKeeper::GetGradeName(ScoreKeeper::GetGradeForRank(rank)));
     DebugAddScreenText(Vec4(.5f, .5f, 0.f, 0.f), Vec2(.5f, .5f), 30.f, Rgba8::RED, Rgba8::RED, .5f, debugText.c_str());
 
     //calibration
     sTotalCalibHit++;
-    sTotalCalibDelta += args.GetValue("delta", 0.f);
-
-    return true;
+    sTotalCalibDelta += judgement.deltaMS;
 }
 
 //////////////////////////////////////////////////////////////////////////
 float Song::GetNoteAgeFromTimeMS(unsigned int startMS) const
 {
-    return ((float)(m_elapsedMS + NOTE_RENDER_MAX_TIME_MS)-(float)startMS)/(float)NOTE_RENDER_MAX_TIME_MS;
+    return GetNoteAgeAtTimeMS(startMS, m_elapsedMS);
 }
 
 //////////////////////////////////////////////////////////////////////////
 void Song::LoadNotesFile()
 {
     std::string notesFile = GetNotesFilePath(m_songPath);
-    Strings lines = FileReadLines(notesFile);
-    if (lines.empty()) {
+    std::string chartFile = GetChartFilePath(m_songPath);
+
+    //the cached hash belongs to the export it was loaded from, a changed export goes back to comparing times
+    FileStamp notesStamp = GetFileStamp(notesFile);
+    bool isCacheValid = m_chartHash != 0 && notesStamp == m_notesStamp;
+
+    //compile on first load or when the Audition export changed
+    std::vector<ChartNoteRecord> csvRecords;
+    bool isJustCompiled = !isCacheValid && !IsChartFileUpToDate(chartFile, notesFile);
+    if (isJustCompiled && !CompileChartFile(notesFile, chartFile, csvRecords)) {
+        return;
+    }
+
+    MappedFile chart;
+    uint32_t noteCount = 0;
+    ChartNoteRecord const* records = nullptr;
+    if (chart.Open(chartFile.c_str())) {
+        records = GetChartRecordsFromMemory(chart.GetData(), chart.GetSize(), noteCount);
+    }
+    bool isChartChanged = records != nullptr && isCacheValid && HashChartRecords(records, noteCount) != m_chartHash;
+    if ((records == nullptr || isChartChanged) && !isJustCompiled && std::filesystem::exists(notesFile)) {
+        //older chart version, a corrupt header or records that no longer match the cache, rebuild it from the export
+        records = nullptr;
+        chart.Close();
+        if (!CompileChartFile(notesFile, chartFile, csvRecords)) {
+            return;
+        }
+        if (chart.Open(chartFile.c_str())) {
+            records = GetChartRecordsFromMemory(chart.GetData(), chart.GetSize(), noteCount);
+        }
+    }
+    if (records == nullptr && !csvRecords.empty()) {    //notes folder not writable
+        records = csvRecords.data();
+        noteCount = (uint32_t)csvRecords.size();
+    }
+    if (records == nullptr) {
+        AddLoadError(Stringf("loading %s failed", chartFile.c_str()));
         m_isValid = false;
         return;
     }
 
-    for (size_t i = 1; i < lines.size(); i++) {
-        std::string line = lines[i];
+    m_timeline.Build(records, noteCount);
+    m_timeline.SetListener(this);
+    if (!m_isCalibration) {
+        m_timeline.SetRecorder(&m_replayRecorder);
+    }
+
+    m_notesStamp = notesStamp;
+    m_noteCount = m_timeline.GetNoteCount();
+    m_chartHash = m_timeline.GetChartHash();
+}
 
-        Strings trunks = SplitStringOnDelimiter(line,'\t');
-        if (trunks.size() == 6) {        
-            unsigned int start = GetMilliSecondsFromString(trunks[1]);
-            unsigned int duration = GetMilliSecondsFromString(trunks[2]);
-            m_notes.push_back(Note::CreateNote(this,trunks[0], start, duration));
-        }
+//////////////////////////////////////////////////////////////////////////
+bool Song::CompileChartFile(std::string const& notesFile, std::string const& chartFile, std::vector<ChartNoteRecord>& outRecords)
+{
+    std::vector<ChartParseError> errors;
+    if (!ReadNotesCSVFile(notesFile, outRecords, errors)) {
+        AddLoadError(Stringf("loading %s failed", notesFile.c_str()));
+        m_isValid = false;
+        return false;
+    }
+    for (ChartParseError const& error : errors) {
+        AddLoadError(Stringf("%s(%u): %s", notesFile.c_str(), error.lineNumber, error.message.c_str()));
+    }
+    if (!WriteChartFile(chartFile, outRecords)) {
+        AddLoadError(Stringf("compiling %s failed", chartFile.c_str()));
     }
+    return true;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -307,7 +461,7 @@ void Song::LoadInfoFile()
     XmlDocument infoDoc;
     XmlError code = infoDoc.LoadFile(infoFile.c_str());
     if(code != XmlError::XML_SUCCESS){
-        g_theConsole->PrintString(Rgba8::RED, Stringf("loading %s failed", infoFile.c_str()));
+        AddLoadError(Stringf("loading %s failed", infoFile.c_str()));
         m_isValid = false;
         return;
     }
@@ -322,24 +476,137 @@ void Song::LoadInfoFile()
     m_length = infoStrings.GetValue("length","00:00");
     m_difficulty = infoStrings.GetValue("difficulty","-");
     m_songLength = GetMilliSecondsFromString(m_length);
-    std::string bgTexPath = infoStrings.GetValue("background","White");
-    m_bgTexture = g_theRenderer->CreateOrGetTextureFromFile(bgTexPath.c_str());
+    m_bgTexturePath = infoStrings.GetValue("background","White");
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::LoadInfoFromManifest(SongManifestEntry const& entry)
+{
+    m_songName = entry.name;
+    m_author = entry.author;
+    m_album = entry.album;
+    m_link = entry.link;
+    m_genres = entry.genres;
+    m_length = entry.length;
+    m_difficulty = entry.difficulty;
+    m_songLength = GetMilliSecondsFromString(m_length);
+    m_bgTexturePath = entry.background;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::LoadChartCacheFromManifest(SongManifestEntry const& entry)
+{
+    //only while the export is the one the chart was loaded from, the hash is still checked at load
+    if (entry.notesStamp == m_notesStamp) {
+        m_noteCount = entry.noteCount;
+        m_chartHash = entry.chartHash;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::LoadSound()
+{
+    m_loadedSound = g_theAudio->CreateSoundHandle(m_soundFilePath);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::LoadBackgroundImage()
+{
+    //names that are not files (engine built-in textures) are left to CreateOrGetTextureFromFile
+    if (m_bgTexturePath.empty() || !std::filesystem::is_regular_file(m_bgTexturePath)) {
+        return;
+    }
+    m_bgImage = new Image(m_bgTexturePath.c_str());
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::RegisterSound()
+{
+    m_soundID = g_theAudio->RegisterSoundHandle(m_soundFilePath, m_loadedSound);
+    m_loadedSound = nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::UploadBackgroundTexture()
+{
+    if (m_bgImage != nullptr) {
+        m_bgTexture = g_theRenderer->CreateTextureFromImage(*m_bgImage);
+        delete m_bgImage;
+        m_bgImage = nullptr;
+    }
+    else if (!m_bgTexturePath.empty()) {    //info file failed otherwise
+        m_bgTexture = g_theRenderer->CreateOrGetTextureFromFile(m_bgTexturePath.c_str());
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::PrintLoadErrors()
+{
+    std::lock_guard<std::mutex> lock(sLoadErrorMutex);
+    for (std::string const& error : m_loadErrors) {
+        g_theConsole->PrintString(Rgba8::RED, error);
+    }
+    m_loadErrors.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::UpdateFileStamps()
+{
+    m_soundStamp = GetFileStamp(m_soundFilePath);
+    m_infoStamp = GetFileStamp(GetInfoFilePath(m_songPath));
+    m_notesStamp = GetFileStamp(GetNotesFilePath(m_songPath));
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool Song::IsManifestEntryUpToDate(SongManifestEntry const& entry) const
+{
+    return entry.isValid && entry.soundStamp == m_soundStamp && entry.infoStamp == m_infoStamp;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::FillManifestEntry(SongManifestEntry& entry) const
+{
+    entry.songFilePath = m_soundFilePath;
+    entry.soundStamp = m_soundStamp;
+    entry.infoStamp = m_infoStamp;
+    entry.notesStamp = m_notesStamp;
+    entry.name = m_songName;
+    entry.author = m_author;
+    entry.album = m_album;
+    entry.link = m_link;
+    entry.genres = m_genres;
+    entry.length = m_length;
+    entry.difficulty = m_difficulty;
+    entry.background = m_bgTexturePath;
+    entry.noteCount = m_noteCount;
+    entry.chartHash = m_chartHash;
+    entry.isValid = m_isValid;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::AddLoadError(std::string const& error)
+{
+    std::lock_guard<std::mutex> lock(sLoadErrorMutex);
+    m_loadErrors.push_back(error);
 }
 
 //////////////////////////////////////////////////////////////////////////
 void Song::BeforePlay()
 {
-    g_theEvents->RegisterMethodEvent("AddScore", this, &Song::AddScore, "add note score to song", EVENT_GAME);
-    sBackground = AssetManager::gAssetManager->GetRandomBackgroundPaths();
+    m_timeline.SetPressDelayMS(gNoteDelayDelta);
+    m_timeline.BeginPlay();
+    m_ticker.SetTickRate(sGameplayTickRate);
+    m_ticker.Reset(0);
+    m_sampledInput.Clear();
+    m_isAutoplaying = sIsAutoplay && !m_isCalibration;
+    if (m_isAutoplaying) {
+        m_autoplay.Build(m_timeline.GetNoteTable(), gNoteDelayDelta, sAutoplayErrorMS);
+    }
+    sBackground = AssetManager::gAssetManager->GetRandomBackground();
     sFireFlicker = AssetManager::gAssetManager->GetRandomFireFlicker();
     m_elapsedMS = 0;
-    m_score = 0;
-    m_comboCount = 0;
-    m_maxCombo = 0;
-    m_perfectCount = 0;
-    m_goodCount = 0;
-    m_fairCount= 0;
-    m_endNoteIndex = 0;
+    m_songClock = SongClock();
+    m_songClock.Reset(0.0, GetInputClockSeconds());
     m_isPlaying = true;
     m_isPaused = false;
 
@@ -350,34 +617,69 @@ void Song::BeforePlay()
 //////////////////////////////////////////////////////////////////////////
 void Song::AfterPlay()
 {
-    g_theEvents->UnsubscribeObject(this);
- 
-    UpdateCombo();
-    m_endNoteIndex = 0;
-    m_currentNotesIndex.clear();
+    m_timeline.EndPlay();
     m_isPlaying = false;
+    m_isAutoplaying = false;
+    WriteReplay();
     m_elapsedMS = 0;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void Song::WriteReplay()
+{
+    ReplayData const& replay = m_replayRecorder.GetReplay();
+    if (m_isCalibration || replay.records.empty()) {
+        return;
+    }
+
+    std::string replayFile = GetReplayFilePath(m_songPath);
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(replayFile).parent_path(), error);
+    if (!WriteReplayFile(replayFile, replay)) {
+        g_theConsole->PrintString(Rgba8::RED, Stringf("writing %s failed", replayFile.c_str()));
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void Song::UpdateScore()
 {    
-    m_highestScore = m_highestScore > m_score ? m_highestScore : m_score;
+    int score = GetScore();
+    m_highestScore = m_highestScore > score ? m_highestScore : score;
 }
 
 //////////////////////////////////////////////////////////////////////////
-void Song::UpdateCombo()
+//starts a paused channel on an exact DSP sample ahead, returns the input clock time of that sample
+static double ScheduleSoundStart(SoundPlaybackID playbackID, double leadSeconds)
 {
-    m_maxCombo = m_maxCombo > m_comboCount ? m_maxCombo : m_comboCount;
-    m_comboCount = 0;
+    FMOD::Channel* channel = (FMOD::Channel*)playbackID;    //engine playback ids are channel pointers
+    FMOD::System* system = nullptr;
+    int sampleRate = 0;
+    unsigned long long parentClock = 0;
+    if (playbackID == (SoundPlaybackID)-1 || channel == nullptr ||
+        channel->getSystemObject(&system) != FMOD_OK ||
+        system->getSoftwareFormat(&sampleRate, nullptr, nullptr) != FMOD_OK || sampleRate <= 0 ||
+        channel->getDSPClock(nullptr, &parentClock) != FMOD_OK) {
+        g_theAudio->SetSoundPaused(playbackID, false);
+        return GetInputClockSeconds();
+    }
+
+    double nowSeconds = GetInputClockSeconds();
+    unsigned long long leadSamples = (unsigned long long)(leadSeconds * (double)sampleRate);
+    channel->setDelay(parentClock + leadSamples, 0, false);
+    channel->setPaused(false);
+    return nowSeconds + (double)leadSamples / (double)sampleRate;
 }
 
 //////////////////////////////////////////////////////////////////////////
 void Song::Start(bool loop)
 {
     BeforePlay();
-    m_soundPlayID = g_theAudio->PlaySound(m_soundID, loop, gMusicVolume);
+    m_soundPlayID = g_theAudio->PlaySound(m_soundID, loop, gMusicVolume, 0.f, 1.f, true);
     g_theAudio->SetSoundCallback(m_soundPlayID, SongManager::EndOfSong);    
+    
+    //note time 0 is the scheduled sample, not whenever this frame happened to run
+    double startSeconds = ScheduleSoundStart(m_soundPlayID, sSongStartLeadSeconds);
+    m_songClock.Reset(0.0, startSeconds);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -385,6 +687,7 @@ void Song::Pause()
 {
     //m_pausedPos = g_theAudio->GetSoundPosition(m_soundPlayID);
     g_theAudio->SetSoundPaused(m_soundPlayID,true);
+    m_songClock.Pause(GetInputClockSeconds());
     m_isPaused = true;
 }
 
@@ -393,16 +696,36 @@ void Song::Resume()
 {    
     m_isPaused = false;
     g_theAudio->SetSoundPaused(m_soundPlayID,false);
+    m_songClock.Resume(GetInputClockSeconds());
 }
 
 //////////////////////////////////////////////////////////////////////////
 void Song::Restart()
 {
-    g_theAudio->SetSoundPosition(m_soundPlayID,0);
-    m_elapsedMS = 0;
+    Seek(0);
     Resume();
 }
 
+//////////////////////////////////////////////////////////////////////////
+void Song::Seek(unsigned int targetMS)
+{
+    if (m_isPlaying) {
+        g_theAudio->SetSoundPosition(m_soundPlayID, targetMS);
+    }
+    SeekNotes(targetMS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void Song::SeekNotes(unsigned int targetMS)
+{
+    m_timeline.Seek(targetMS);
+    m_ticker.Reset(targetMS);
+    m_sampledInput.Clear();
+    m_autoplay.SeekTo(targetMS);
+    m_elapsedMS = targetMS;
+    m_songClock.Reset((double)targetMS, GetInputClockSeconds());
+}
+
 //////////////////////////////////////////////////////////////////////////
 void Song::Stop()
 {
@@ -414,17 +737,41 @@ void Song::Stop()
 void Song::UpdateSoundTime()
 {
     if (m_isPlaying && !m_isPaused) {
-         unsigned int newMS = g_theAudio->GetSoundPosition(m_soundPlayID);
-         if (m_elapsedMS > newMS) {
-             m_endNoteIndex = 0;
+         unsigned int audioMS = g_theAudio->GetSoundPosition(m_soundPlayID);
+         m_elapsedSampleSeconds = GetInputClockSeconds();
+         bool isSnapped = m_songClock.Update((double)audioMS, m_elapsedSampleSeconds);
+         double clockMS = m_songClock.GetTimeMSAt(m_elapsedSampleSeconds);
+         unsigned int newMS = clockMS > 0.0 ? (unsigned int)clockMS : 0;
+         if (isSnapped && m_elapsedMS > newMS) { //looped or seeked back
+             SeekNotes(newMS);
          }
-         m_elapsedMS = newMS;
+         m_elapsedMS = newMS > m_elapsedMS ? newMS : m_elapsedMS;
          if (sInstantRank > 1.f) {
              sInstantRank-=1.f;
          }
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+uint32_t Song::GetRenderTimeMS() const
+{
+    //notes are as of the last tick, move them on to the clock but never past the next tick
+    uint32_t tickedMS = m_timeline.GetElapsedMS();
+    if (!m_isPlaying || m_isPaused) {
+        return tickedMS;
+    }
+    double clockMS = GetPredictedSongTimeMS();
+    double nextTickMS = (double)(tickedMS + m_ticker.GetTickMS());
+    clockMS = clockMS < (double)tickedMS ? (double)tickedMS : (clockMS > nextTickMS ? nextTickMS : clockMS);
+    return (uint32_t)clockMS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+double Song::GetPredictedSongTimeMS() const
+{
+    return m_songClock.GetTimeMSAt(GetInputClockSeconds());
+}
+
 //////////////////////////////////////////////////////////////////////////
 float Song::GetSongProgress() const
 {
@@ -434,20 +781,22 @@ float Song::GetSongProgress() const
 //////////////////////////////////////////////////////////////////////////
 std::string Song::GetEndingTextForSong() const
 {
+    ScoreKeeper const& scoreKeeper = m_timeline.GetScoreKeeper();
     std::string text = Stringf("Score: %i\nMaxCombo: %u\n\nPerfect: %u\nGood: %u\nFair: %u\nMiss: %u", 
-        m_score, m_maxCombo, m_perfectCount, m_goodCount, m_fairCount, 
-        (unsigned int)m_notes.size()-m_perfectCount-m_goodCount-m_fairCount);
+        scoreKeeper.GetScore(), scoreKeeper.GetMaxCombo(), scoreKeeper.GetPerfectCount(), scoreKeeper.GetGoodCount(),
+        scoreKeeper.GetFairCount(), scoreKeeper.GetMissCount(m_timeline.GetNoteCount()));
     return text;
 }
 
 //////////////////////////////////////////////////////////////////////////
 std::string Song::GetDebugTextForSong() const
 {
-    std::string text = Stringf("%s\n%s\n%.3f: %u/%u\n%u\nIsPlaying: %s\nScore: %i", 
+    std::string text = Stringf("%s\n%s\n%.3f: %u/%u\n%u (clock %+.2fms x%.4f)\nTicks: %u/frame (max %u, skipped %u)\nIsPlaying: %s\nScore: %i", 
         m_songName.c_str(), m_author.c_str(), GetSongProgress(),
         m_elapsedMS, m_songLength,
-        g_theAudio->GetSoundPosition(m_soundPlayID),
-        m_isPlaying ? "true" : "false", m_score);
+        g_theAudio->GetSoundPosition(m_soundPlayID), m_songClock.GetLastErrorMS(), m_songClock.GetRate(),
+        m_ticker.GetLastTickCount(), m_ticker.GetMaxTickCount(), m_ticker.GetSkippedCount(),
+        m_isPlaying ? "true" : "false", GetScore());
     return text;
 }
 
@@ -467,6 +816,15 @@ std::string GetNotesFilePath(std::string const& songFilePath)
     return CombineStringsWithDelimiter(paths,'/') + "/notes/"+name+".csv";
 }
 
+//////////////////////////////////////////////////////////////////////////
+std::string GetChartFilePath(std::string const& songFilePath)
+{
+    Strings paths = SplitStringOnDelimiter(songFilePath, '/');
+    std::string name = paths.back();
+    paths.pop_back();
+    return CombineStringsWithDelimiter(paths, '/') + "/notes/" + name + ".chart";
+}
+
 //////////////////////////////////////////////////////////////////////////
 std::string GetInfoFilePath(std::string const& songFilePath)
 {
@@ -476,6 +834,13 @@ std::string GetInfoFilePath(std::string const& songFilePath)
     return CombineStringsWithDelimiter(paths, '/') + "/info/" + name + ".xml";
 }
 
+//////////////////////////////////////////////////////////////////////////
+std::string GetReplayFilePath(std::string const& songFilePath)
+{
+    Strings paths = SplitStringOnDelimiter(songFilePath, '/');
+    return "data/log/replays/" + paths.back() + ".replay";
+}
+
 //////////////////////////////////////////////////////////////////////////
 unsigned int GetMilliSecondsFromString(std::string const& timeString)
 {
@@ -507,9 +872,3 @@ bool IsNameUpNode(std::string const& name)
     }
     else return false;
 }
-
-//////////////////////////////////////////////////////////////////////////
-float GetScoreMultiplierFromComboCount(unsigned int comboCount)
-{
-    return Clamp((float)comboCount/(float)COMBO_SINGLE_RATE_COUNT, 1.f, COMBO_MAX_RATE);
-}
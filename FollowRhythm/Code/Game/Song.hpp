@@ -2,71 +2,111 @@
 
 #include <string>
 #include <vector>
-#include <list>
+#include <atomic>
+#include "Game/SongManifest.hpp"
+#include "Game/SongTimeline.hpp"
+#include "Game/SongClock.hpp"
+#include "Game/ReplayFile.hpp"
+#include "Game/AutoplayInput.hpp"
+#include "Game/GameplayTicker.hpp"
 #include "Engine/Core/EventSystem.hpp"
 
 typedef size_t SoundID;
 typedef size_t SoundPlaybackID;
 class Clock;
-class Note;
 class Texture;
+class Image;
 class SongManager;
+class InputSampler;
 struct AABB2;
 struct Vertex_PCU;
+namespace FMOD { class Sound; }
 
 std::string GetMusicPathWithoutEXT(std::string const& rawMusicPath);
 std::string GetNotesFilePath(std::string const& songFilePath);
+std::string GetChartFilePath(std::string const& songFilePath);
 std::string GetInfoFilePath(std::string const& songFilePath);
+std::string GetReplayFilePath(std::string const& songFilePath);
 unsigned int GetMilliSecondsFromString(std::string const& timeString);
 bool IsNameLeftNode(std::string const& name);
 bool IsNameUpNode(std::string const& name); //only for multi-notes
-float GetScoreMultiplierFromComboCount(unsigned int comboCount);
 
-//actual worker for a song
-class Song
+//actual worker for a song, the platform side around a SongTimeline
+class Song : public SongTimelineListener
 {
     friend class SongManager;
 
 public:
     static float GetAverageCalibrationDeltaTime();
+    static bool  CompileNotesFile(std::string const& songFilePath);
+    static void  SetAutoplay(bool isEnabled, float errorStdDevMS = 0.f);   //takes effect from the next play
+    static void  SetGameplayTickRate(int ticksPerSecond);                  //takes effect from the next play
 
-    Song(char const* songName);
+    Song(char const* songFilePath);
     ~Song();
 
+    //loading steps, the Load ones are safe to run on worker threads concurrently
+    void LoadInfoFile();
+    void LoadInfoFromManifest(SongManifestEntry const& entry);
+    void LoadChartCacheFromManifest(SongManifestEntry const& entry);
+    void LoadSound();                   //creates the FMOD sound
+    void LoadBackgroundImage();         //decodes only, after the info
+    void RegisterSound();               //main thread only, after LoadSound
+    void UploadBackgroundTexture();     //main thread only, after LoadBackgroundImage
+    void PrintLoadErrors();
+
+    void UpdateFileStamps();
+    bool IsManifestEntryUpToDate(SongManifestEntry const& entry) const;
+    void FillManifestEntry(SongManifestEntry& entry) const;
+
+    //charts are loaded on demand and released by SongManager
+    bool LoadNotes();
+    void UnloadNotes();
+    bool AreNotesLoaded() const { return m_areNotesLoaded; }
+
     void UpdateForCurrentNotes();
+    void UpdateForSampledInput(InputSampler& sampler);
     void UpdateForPlayInput();
     void Render(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const;
 
-    bool AddScore(EventArgs& args);
+    void OnJudgement(Judgement const& judgement) override;
 
     float        GetNoteAgeFromTimeMS(unsigned int startMS) const;    //return [0~1]
     float        GetSongProgress() const;
     unsigned int GetSongElapsedMS() const {return m_elapsedMS;}
+    int          GetScore() const {return m_timeline.GetScoreKeeper().GetScore();}
+    double       GetPredictedSongTimeMS() const;    //song clock sampled right now, between frames too
     std::string  GetEndingTextForSong() const;
     std::string  GetDebugTextForSong() const;
 
 private:
     void LoadNotesFile();
-    void LoadInfoFile();
+    bool CompileChartFile(std::string const& notesFile, std::string const& chartFile, std::vector<ChartNoteRecord>& outRecords);
+    void AddLoadError(std::string const& error);
 
     void BeforePlay();
     void AfterPlay();
     void UpdateScore();
-    void UpdateCombo();
+    void WriteReplay();
 
     void Start(bool loop=false);
     void Pause();
     void Resume();
     void Restart(); //Not Used for now
+    void Seek(unsigned int targetMS);
+    void SeekNotes(unsigned int targetMS);
     void Stop();    //Not Used for now
 
     void UpdateSoundTime();
+    uint32_t GetRenderTimeMS() const;
 
 private:
+    std::string m_soundFilePath;
     std::string m_songPath;
-    bool m_isValid = true;
+    std::atomic<bool> m_isValid = true;
     bool m_isCalibration = false;
-    SoundID m_soundID;
+    SoundID m_soundID = (SoundID)-1;
+    FMOD::Sound* m_loadedSound = nullptr;   //created on a worker, until the audio system takes it
     SoundPlaybackID m_soundPlayID;
     bool m_isPlaying = false;
     bool m_isPaused = false;
@@ -78,20 +118,28 @@ private:
     std::string m_genres;
     std::string m_length;    
     std::string m_difficulty;
+    std::string m_bgTexturePath;
+    FileStamp m_soundStamp;
+    FileStamp m_infoStamp;
+    FileStamp m_notesStamp;     //notes csv the chart cache belongs to
+    uint32_t m_noteCount = 0;
+    uint64_t m_chartHash = 0;   //0 until the chart was loaded once, then checked on every load
     Texture* m_bgTexture = nullptr;
+    Image* m_bgImage = nullptr;     //decoded on a worker, until it is uploaded
+    std::vector<std::string> m_loadErrors;
     int m_highestScore = 0;
 
-    int m_score = 0;
-    unsigned int m_comboCount = 0;
-    unsigned int m_maxCombo = 0;
-    unsigned int m_perfectCount = 0;
-    unsigned int m_goodCount = 0;
-    unsigned int m_fairCount = 0;
-
     unsigned int m_songLength = 0;
     unsigned int m_elapsedMS = 0;
-
-    std::vector<Note*> m_notes;
-    std::list<size_t> m_currentNotesIndex;
-    size_t m_endNoteIndex = 0;
+    double m_elapsedSampleSeconds = 0.0;   //input clock time m_elapsedMS was read at
+    SongClock m_songClock;                 //smoothed audio position on the input clock
+    bool m_isInputSampled = false;         //presses come from the sampler thread instead of the frame
+    bool m_isAutoplaying = false;          //inputs come from m_autoplay, the controller is ignored
+    AutoplayInputSource m_autoplay;
+    BufferedInputSource m_sampledInput;    //sampler events waiting for the tick they fall in
+    GameplayTicker m_ticker;               //judgement and note retirement run at the tick rate, not the frame rate
+
+    bool m_areNotesLoaded = false;
+    SongTimeline m_timeline;
+    ReplayRecorder m_replayRecorder;    //every play but calibration, written when the play ends
 };
\ No newline at end of file
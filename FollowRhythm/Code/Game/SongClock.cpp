@@ -0,0 +1,90 @@
+#include "Game/SongClock.hpp"
+#include <cmath>
+
+//////////////////////////////////////////////////////////////////////////
+static double ClampDouble(double value, double minValue, double maxValue)
+{
+    return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongClock::Reset(double songMS, double hostSeconds)
+{
+    m_anchorMS = songMS;
+    m_anchorSeconds = hostSeconds;
+    m_rate = m_driftRate;
+    m_lastAudioMS = -1.0;
+    m_lastReadSeconds = hostSeconds;
+    m_lastErrorMS = 0.0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool SongClock::Update(double audioMS, double hostSeconds)
+{
+    if (m_isPaused || hostSeconds < m_anchorSeconds) {   //scheduled start not reached, audio still silent
+        return false;
+    }
+
+    //the same position again only says the next block is not mixed yet
+    if (audioMS == m_lastAudioMS) {
+        m_lastReadSeconds = hostSeconds;
+        return false;
+    }
+
+    //positions are block starts, the smallest forward step seen is the block size
+    double stepMS = audioMS - m_lastAudioMS;
+    if (m_lastAudioMS >= 0.0 && stepMS > 0.0 && (m_blockMS == 0.0 || stepMS < m_blockMS)) {
+        m_blockMS = stepMS;
+    }
+    m_lastAudioMS = audioMS;
+
+    //the block started after the last read at the earliest, aim at the middle of what is left
+    double sinceLastReadMS = (hostSeconds - m_lastReadSeconds) * 1000.0;
+    double uncertaintyMS = sinceLastReadMS < m_blockMS ? sinceLastReadMS : m_blockMS;
+    m_lastReadSeconds = hostSeconds;
+    double predictedMS = GetTimeMSAt(hostSeconds);
+    double errorMS = audioMS + uncertaintyMS * .5 - predictedMS;
+    m_lastErrorMS = errorMS;
+    if (fabs(errorMS) > SONG_CLOCK_SNAP_MS) {
+        Reset(audioMS, hostSeconds);
+        m_lastAudioMS = audioMS;
+        return true;
+    }
+
+    //re-anchor at the prediction so the time never jumps, then steer the rate
+    m_anchorMS = predictedMS;
+    m_anchorSeconds = hostSeconds;
+    m_driftRate = ClampDouble(m_driftRate + errorMS * SONG_CLOCK_DRIFT_GAIN, 1.0 - SONG_CLOCK_MAX_DRIFT, 1.0 + SONG_CLOCK_MAX_DRIFT);
+    double slew = ClampDouble(errorMS * SONG_CLOCK_SLEW_PER_SECOND * .001, -SONG_CLOCK_MAX_SLEW, SONG_CLOCK_MAX_SLEW);
+    m_rate = m_driftRate + slew;
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongClock::Pause(double hostSeconds)
+{
+    if (m_isPaused) {
+        return;
+    }
+    m_anchorMS = GetTimeMSAt(hostSeconds);
+    m_anchorSeconds = hostSeconds;
+    m_isPaused = true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongClock::Resume(double hostSeconds)
+{
+    m_anchorSeconds = hostSeconds;
+    m_lastAudioMS = -1.0;
+    m_lastReadSeconds = hostSeconds;
+    m_isPaused = false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+double SongClock::GetTimeMSAt(double hostSeconds) const
+{
+    if (m_isPaused) {
+        return m_anchorMS;
+    }
+    return m_anchorMS + (hostSeconds - m_anchorSeconds) * 1000.0 * m_rate;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+constexpr double SONG_CLOCK_SNAP_MS = 100.0;        //errors past this are seeks, loops or hitches, jump instead of slew
+constexpr double SONG_CLOCK_SLEW_PER_SECOND = 1.0;  //fraction of the error removed per second of song time
+constexpr double SONG_CLOCK_MAX_SLEW = .05;         //slew never changes the rate by more than this
+constexpr double SONG_CLOCK_DRIFT_GAIN = .000002;    //rate change per ms of error, learns steady drift
+constexpr double SONG_CLOCK_MAX_DRIFT = .01;
+
+//song time extrapolated from a host clock and steered toward the coarse audio position
+//the audio position only moves in mixer blocks, so it is a noisy measurement, not the time itself
+//corrections change the rate instead of the value, time stays continuous and monotonic until a snap
+class SongClock
+{
+public:
+    void Reset(double songMS, double hostSeconds);     //hostSeconds may be in the future for a scheduled start
+    bool Update(double audioMS, double hostSeconds);    //true when it had to snap to the audio position
+    void Pause(double hostSeconds);
+    void Resume(double hostSeconds);
+
+    double GetTimeMSAt(double hostSeconds) const;       //any host time, including predicted present time
+    double GetRate() const { return m_rate; }
+    double GetLastErrorMS() const { return m_lastErrorMS; }
+
+private:
+    double m_anchorMS = 0.0;
+    double m_anchorSeconds = 0.0;
+    double m_rate = 1.0;        //song ms per host ms, drift plus slew
+    double m_driftRate = 1.0;
+    double m_lastAudioMS = -1.0;
+    double m_lastReadSeconds = 0.0;
+    double m_blockMS = 0.0;     //mixer block size learned from position steps
+    double m_lastErrorMS = 0.0;
+    bool m_isPaused = false;
+};
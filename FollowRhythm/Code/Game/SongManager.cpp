@@ -1,18 +1,27 @@
 #include "Game/SongManager.hpp"
 #include "Game/Song.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/FrameVertexArena.hpp"
 #include "Game/Game.hpp"
 #include "Game/CircleButtonList.hpp"
+#include "Game/TaskPool.hpp"
+#include "Game/SongManifest.hpp"
+#include "Game/TextLayoutCache.hpp"
+#include "Game/AssetManager.hpp"
+#include "Game/GameAudioSystem.hpp"
 #include "Engine/Core/Clock.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Input/XboxController.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
+#include <algorithm>
 
 SongManager* SongManager::sSongManager = nullptr;
 
@@ -21,6 +30,8 @@ static ButtonList sPauseMenu;
 static ButtonList sEndMenu;
 static const char sScoreDelimiter = '\t';
 static const char* sScoreFilePath = "data/log/highscore.txt";
+static const char* sMusicFolderPath = "data/music/";
+static const char* sManifestFilePath = "data/log/songlibrary.txt";
 
 enum sPauseMenuItem
 {
@@ -29,6 +40,43 @@ enum sPauseMenuItem
     PAUSE_QUIT
 };
 
+//////////////////////////////////////////////////////////////////////////
+COMMAND(CompileCharts, "compile all notes csv into binary charts", eEventFlag::EVENT_GLOBAL)
+{
+    UNUSED(args);
+    std::vector<std::string> musicList = FilesFindInDirectory(sMusicFolderPath, "*.mp3");
+    for (std::string musicPath : musicList) {
+        std::string songPath = GetMusicPathWithoutEXT(musicPath);
+        if (Song::CompileNotesFile(songPath)) {
+            g_theConsole->PrintString(Rgba8::GREEN, Stringf("compiled %s", GetChartFilePath(songPath).c_str()));
+        }
+        else {
+            g_theConsole->PrintString(Rgba8::RED, Stringf("compiling %s failed", GetNotesFilePath(songPath).c_str()));
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+COMMAND(SeekSong, "jump the playing song to a time, ms=0", eEventFlag::EVENT_GLOBAL)
+{
+    int targetMS = args.GetValue("ms", 0);
+    if (SongManager::sSongManager != nullptr) {
+        SongManager::sSongManager->SeekCurrentSong(targetMS < 0 ? 0 : (unsigned int)targetMS);
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+COMMAND(Autoplay, "let a bot play the next songs, enabled=true error=0 (gaussian ms)", eEventFlag::EVENT_GLOBAL)
+{
+    bool isEnabled = args.GetValue("enabled", true);
+    float errorMS = args.GetValue("error", 0.f);
+    Song::SetAutoplay(isEnabled, errorMS);
+    g_theConsole->PrintString(Rgba8::GREEN, isEnabled ? Stringf("autoplay on, timing error %.1fms", errorMS) : "autoplay off");
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 static void InitPauseMenuButtons(AABB2 const& bounds)
 {
@@ -42,7 +90,7 @@ static void InitPauseMenuButtons(AABB2 const& bounds)
     singleBound.Translate(singleTrans);
     sPauseMenu.m_buttons.push_back(Button("Quit", false, singleBound));
 
-    sPauseMenu.m_buttonTex = g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/6-new.png");
+    sPauseMenu.m_buttonTex = AssetManager::gAssetManager->GetTexture(TEXTURE_BUTTON);
 }
 
 static void InitEndMenuButtons(AABB2 const& bounds)
@@ -50,32 +98,69 @@ static void InitEndMenuButtons(AABB2 const& bounds)
     sEndMenu.m_buttons.push_back(Button("Back", true, bounds));
 
     sEndMenu.m_textColor = Rgba8::BLACK;
-    sEndMenu.m_buttonTex = g_theRenderer->CreateOrGetTextureFromFile("data/images/buttons-2d/6-new.png");
+    sEndMenu.m_buttonTex = AssetManager::gAssetManager->GetTexture(TEXTURE_BUTTON);
 }
 
 //////////////////////////////////////////////////////////////////////////
 static void RenderForPause(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts)
 {
     //overlay background
-    g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+    BindTexture(nullptr);
     g_theRenderer->DrawAABB2D(bounds, Rgba8(255, 255, 255, 100));
 
     Vec2 uiDim = bounds.GetDimensions();
-    g_theFont->AddVertsForTextInBox2D(textVerts, bounds.GetBoxAtTop(.2f), uiDim.y * .08f, "Pause", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+    g_theTextLayouts->AddVertsForTextInBox2D(textVerts, bounds.GetBoxAtTop(.2f), uiDim.y * .08f, "Pause", Rgba8::WHITE, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
     sPauseMenu.Render(textVerts);
 }
 
 //////////////////////////////////////////////////////////////////////////
 SongManager::SongManager(Game* game, char const* musicFolderPath)
     : m_game(game)
+    , m_musicFolderPath(musicFolderPath)
 {
     if (sSongManager != nullptr) {
         ERROR_AND_DIE("Multiple music manager inited");
     }
 
+    //the folder scan is cheap and always runs, the manifest saves reparsing info files and loading charts
+    //edits under a song's Info/ or Notes/ never touch the music folder's own stamp
+    SongManifest manifest;
+    ReadSongManifest(sManifestFilePath, manifest);
     std::vector<std::string> musicList = FilesFindInDirectory(musicFolderPath, "*.mp3");
-    for(std::string musicPath : musicList){
-        Song* newSong = new Song(musicPath.c_str());
+
+    std::vector<Song*> loadedSongs;
+    loadedSongs.reserve(musicList.size());
+    {
+        TaskPool loadPool;
+        for (std::string const& musicPath : musicList) {
+            Song* newSong = new Song(musicPath.c_str());
+            loadedSongs.push_back(newSong);
+
+            SongManifestEntry const* entry = manifest.FindEntry(musicPath);
+            loadPool.Submit([newSong, entry, &loadPool]() {
+                newSong->UpdateFileStamps();
+                if (entry != nullptr) {
+                    newSong->LoadChartCacheFromManifest(*entry);
+                }
+                if (entry != nullptr && newSong->IsManifestEntryUpToDate(*entry)) {
+                    newSong->LoadInfoFromManifest(*entry);
+                }
+                else {
+                    newSong->LoadInfoFile();
+                }
+                newSong->LoadBackgroundImage();
+                loadPool.SubmitToMainThread([newSong]() { newSong->UploadBackgroundTexture(); });
+            });
+            loadPool.Submit([newSong, &loadPool]() {
+                newSong->LoadSound();
+                loadPool.SubmitToMainThread([newSong]() { newSong->RegisterSound(); });
+            });
+        }
+        loadPool.WaitForAllAndRunMainThreadTasks();
+    }
+
+    for(Song* newSong : loadedSongs){
+        newSong->PrintLoadErrors();
         //TODO for debug music list
         if (!newSong->m_isCalibration) {            
             m_songs.push_back(newSong);
@@ -85,9 +170,15 @@ SongManager::SongManager(Game* game, char const* musicFolderPath)
         }
     }
 
+    int residencyCap = g_gameConfigBlackboard->GetValue("songResidencyCap", 2);
+    m_residencyCap = residencyCap < 1 ? 1 : (size_t)residencyCap;
+    m_inputSampleRate = g_gameConfigBlackboard->GetValue("inputSampleRate", 1000);
+    Song::SetGameplayTickRate(g_gameConfigBlackboard->GetValue("gameplayTickRate", (int)GAMEPLAY_DEFAULT_TICK_RATE));
+
     sSongManager = this;
     m_timer = new Timer();
     ReadHighScore();
+    WriteManifest();
 
     //init pause menu
     AABB2 bounds = game->GetWorldCamera()->GetBounds();
@@ -107,7 +198,9 @@ SongManager::SongManager(Game* game, char const* musicFolderPath)
 //////////////////////////////////////////////////////////////////////////
 SongManager::~SongManager()
 {
+    m_inputSampler.Stop();
     WriteHighScore();
+    WriteManifest();
     for (Song* s : m_songs) {
         delete s;
     }
@@ -134,6 +227,7 @@ void SongManager::ClearScoreHistory()
 //////////////////////////////////////////////////////////////////////////
 void SongManager::Update()
 {
+    UpdateForEndOfSong();
     UpdateForSong();
     UpdateForInput();
 }
@@ -141,7 +235,7 @@ void SongManager::Update()
 //////////////////////////////////////////////////////////////////////////
 void SongManager::Render(AABB2 const& bounds) const
 {
-    std::vector<Vertex_PCU> textVerts;
+    std::vector<Vertex_PCU>& textVerts = g_theFrameVerts->Acquire();
     m_currentSong->Render(bounds, textVerts);
 
     if (m_songState == SONG_START) {
@@ -158,16 +252,24 @@ void SongManager::Render(AABB2 const& bounds) const
         RenderForEnding(bounds, textVerts);
     }
 
-    g_theRenderer->BindDiffuseTexture(g_theFont->GetTexture());
+    BindTexture(g_theFont->GetTexture());
     g_theRenderer->DrawVertexArray(textVerts);
 }
 
+//////////////////////////////////////////////////////////////////////////
+void SongManager::SelectSong(unsigned int songIndex)
+{
+    if (songIndex < m_songs.size()) {
+        MakeSongResident(m_songs[songIndex]);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool SongManager::StartPlaySong(unsigned int songIndex)
 {
     m_currentSongIndex = songIndex;
     m_currentSong = m_songs[m_currentSongIndex];
-    if (!m_currentSong->m_isValid) {
+    if (!MakeSongResident(m_currentSong)) {
         return false;
     }
 
@@ -180,31 +282,43 @@ bool SongManager::StartPlaySong(unsigned int songIndex)
 void SongManager::StartCalibration()
 {
     m_currentSong = sCalibrateSong;
+    m_currentSong->LoadNotes();
     m_currentSong->Start(true);
+    StartInputSampler();
     m_songState = SONG_PLAY;
 }
 
 //////////////////////////////////////////////////////////////////////////
 void SongManager::StopCalibration()
 {
+    m_inputSampler.Stop();
     m_currentSong->Stop();
+    m_currentSong->UnloadNotes();
     m_currentSong = nullptr;
     m_songState = SONG_NULL;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void SongManager::SeekCurrentSong(unsigned int targetMS)
+{
+    if (m_currentSong == nullptr || (m_songState != SONG_PLAY && m_songState != SONG_PAUSE)) {
+        return;
+    }
+    m_currentSong->Seek(targetMS);
+}
+
 //////////////////////////////////////////////////////////////////////////
 FMOD_RESULT F_CALLBACK SongManager::EndOfSong(FMOD_CHANNELCONTROL* channelControl, 
     FMOD_CHANNELCONTROL_TYPE controlType, FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType, 
     void* commanData1, void* commanData2)
 {
-    UNUSED(channelControl);
     UNUSED(controlType);
     UNUSED(commanData1);
     UNUSED(commanData2);
 
+    //FMOD thread, only hand the channel over, the game thread does the rest in UpdateForEndOfSong
     if(callbackType==FMOD_CHANNELCONTROL_CALLBACK_END){
-        sSongManager->m_currentSong->AfterPlay();
-        sSongManager->m_songState = SONG_FINISH;
+        sSongManager->m_endedChannel.store(channelControl, std::memory_order_release);
     }
     return FMOD_OK;
 }
@@ -238,6 +352,24 @@ void SongManager::ReadHighScore()
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+void SongManager::WriteManifest() const
+{
+    SongManifest manifest;
+    for (Song* song : m_songs) {
+        manifest.entries.emplace_back();
+        song->FillManifestEntry(manifest.entries.back());
+    }
+    if (sCalibrateSong != nullptr) {
+        manifest.entries.emplace_back();
+        sCalibrateSong->FillManifestEntry(manifest.entries.back());
+    }
+
+    if (!WriteSongManifest(sManifestFilePath, manifest)) {
+        g_theConsole->PrintString(Rgba8::RED, Stringf("writing %s failed", sManifestFilePath));
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void SongManager::WriteHighScore()
 {
@@ -255,6 +387,55 @@ void SongManager::StartPlayCurrentSong()
 {
     m_currentSong = m_songs[m_currentSongIndex];
     m_currentSong->Start();
+    StartInputSampler();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongManager::EndPlayCurrentSong()
+{
+    m_inputSampler.Stop();
+    m_currentSong = nullptr;
+    TrimResidentSongs();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongManager::StartInputSampler()
+{
+    if (m_inputSampleRate > 0 && !m_inputSampler.Start(0, m_inputSampleRate)) {
+        g_theConsole->PrintString(Rgba8::YELLOW, "input sampler unavailable, using per frame input");
+        m_inputSampleRate = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool SongManager::MakeSongResident(Song* song)
+{
+    auto iter = std::find(m_residentSongs.begin(), m_residentSongs.end(), song);
+    if (iter != m_residentSongs.end()) {
+        m_residentSongs.erase(iter);
+    }
+
+    if (!song->LoadNotes()) {
+        return false;
+    }
+
+    m_residentSongs.push_back(song);
+    TrimResidentSongs();
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongManager::TrimResidentSongs()
+{
+    for (auto iter = m_residentSongs.begin(); iter != m_residentSongs.end() && m_residentSongs.size() > m_residencyCap;) {
+        Song* song = *iter;
+        if (song == m_currentSong) {
+            iter++;
+            continue;
+        }
+        song->UnloadNotes();
+        iter = m_residentSongs.erase(iter);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -297,7 +478,7 @@ void SongManager::UpdateForInput()
             }
             case PAUSE_QUIT:            {
                 m_currentSong->Stop();
-                m_currentSong = nullptr;
+                EndPlayCurrentSong();
                 m_game->EndOfSong();
                 m_songState = SONG_NULL;
                 break;
@@ -313,7 +494,7 @@ void SongManager::UpdateForInput()
     else if (m_songState == SONG_FINISH) {
         if (controller.GetButtonState(gConfirmButton).WasJustPressed()) {
             m_currentSong->UpdateScore();
-            m_currentSong = nullptr;
+            EndPlayCurrentSong();
             m_songState = SONG_NULL;
             m_game->EndOfSong();
             g_theAudio->PlaySound(gButtonSFXID, false, gSFXVolume);
@@ -321,6 +502,25 @@ void SongManager::UpdateForInput()
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+void SongManager::UpdateForEndOfSong()
+{
+    FMOD_CHANNELCONTROL* endedChannel = m_endedChannel.exchange(nullptr, std::memory_order_acquire);
+    if (endedChannel == nullptr || m_currentSong == nullptr) {
+        return;
+    }
+
+    //stopping a song for restart or quit also ends its channel, only a natural end finishes the song
+    if ((SoundPlaybackID)endedChannel != m_currentSong->m_soundPlayID ||
+        (m_songState != SONG_PLAY && m_songState != SONG_PAUSE)) {
+        return;
+    }
+
+    m_inputSampler.Stop();
+    m_currentSong->AfterPlay();
+    m_songState = SONG_FINISH;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void SongManager::UpdateForSong()
 {
@@ -328,10 +528,12 @@ void SongManager::UpdateForSong()
         if (m_timer->HasElapsed()) {
             m_songState = SONG_PLAY;
             m_currentSong->Start();
+            StartInputSampler();
         }
     }
     else if (m_songState == SONG_PLAY) {
         m_currentSong->UpdateSoundTime();
+        m_currentSong->UpdateForSampledInput(m_inputSampler);   //queued for the ticks below
         m_currentSong->UpdateForCurrentNotes();
     }
 }
@@ -339,22 +541,22 @@ void SongManager::UpdateForSong()
 //////////////////////////////////////////////////////////////////////////
 void SongManager::RenderForEnding(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const
 {
-    g_theRenderer->BindDiffuseTexture((Texture*)nullptr);
+    BindTexture(nullptr);
     g_theRenderer->DrawAABB2D(bounds, Rgba8(255,255,255,200));
 
     Vec2 dim = bounds.GetDimensions();
     
     AABB2 titleBound = bounds.GetBoxAtTop(.2f);
-    g_theFont->AddVertsForTextInBox2D(textVerts, titleBound, dim.y*.11f, m_currentSong->m_songName, Rgba8::BLACK, FONT_DEFAULT_ASPECT);
+    g_theTextLayouts->AddVertsForTextInBox2D(textVerts, titleBound, dim.y*.11f, m_currentSong->m_songName, Rgba8::BLACK, FONT_DEFAULT_ASPECT);
 
     AABB2 contentBound = bounds.GetBoxAtBottom(.6f);
-    g_theFont->AddVertsForTextInBox2D(textVerts, contentBound, dim.y*.05f, m_currentSong->GetEndingTextForSong(), 
+    g_theTextLayouts->AddVertsForTextInBox2D(textVerts, contentBound, dim.y*.05f, m_currentSong->GetEndingTextForSong(), 
         Rgba8::BLACK, FONT_DEFAULT_ASPECT, ALIGN_TOP_CENTER, .05f, FONT_DEFAULT_KERNING);
 
-    if (m_currentSong->m_score > m_currentSong->m_highestScore) {
+    if (m_currentSong->GetScore() > m_currentSong->m_highestScore) {
         AABB2 propBound = bounds.GetBoxAtBottom(.8f);
         propBound.ChopBoxOffBottom(.75f);
-        g_theFont->AddVertsForTextInBox2D(textVerts, propBound, dim.y*.08f, "NEW RECORD!!", Rgba8::YELLOW, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
+        g_theTextLayouts->AddVertsForTextInBox2D(textVerts, propBound, dim.y*.08f, "NEW RECORD!!", Rgba8::YELLOW, FONT_DEFAULT_ASPECT, ALIGN_CENTERED, .05f, FONT_DEFAULT_KERNING);
     }
 
     sEndMenu.Render(textVerts);
@@ -374,16 +576,19 @@ std::string SongManager::GetDebugTextForCurrentSong() const
 std::string SongManager::GetSelectedSongInfo(unsigned int selectIndex) const
 {
     Song* selectSong = m_songs[selectIndex];
+    //from the manifest, a song never played yet shows no count until its chart is loaded
+    std::string noteCount = selectSong->m_chartHash != 0 ? std::to_string(selectSong->m_noteCount) : "-";
     std::string info=Stringf("\
 Name:   %s\n\
 Author: %s\n\
 Album:  %s\n\
 Genres: %s\n\
 Length: %s\n\
+Notes:  %s\n\
 Score:  %i\n\
 Difficulty: %s", 
     selectSong->m_songName.c_str(), selectSong->m_author.c_str(), selectSong->m_album.c_str(),
-     selectSong->m_genres.c_str(), selectSong->m_length.c_str(), selectSong->m_highestScore,
+     selectSong->m_genres.c_str(), selectSong->m_length.c_str(), noteCount.c_str(), selectSong->m_highestScore,
      selectSong->m_difficulty.c_str());
     return info;
 }
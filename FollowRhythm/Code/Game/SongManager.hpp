@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <string>
+#include <atomic>
+#include "Game/InputSampler.hpp"
 #include "ThirdParty/fmod/fmod_common.h"
 
 class Song;
@@ -40,9 +42,11 @@ public:
     void Update();
     void Render(AABB2 const& bounds) const;
     
+    void SelectSong(unsigned int songIndex);
     bool StartPlaySong(unsigned int songIndex);
     void StartCalibration();
     void StopCalibration();
+    void SeekCurrentSong(unsigned int targetMS);
 
     std::string GetDebugTextForCurrentSong() const;
     std::string GetSelectedSongInfo(unsigned int selectIndex) const;
@@ -53,10 +57,17 @@ private:
 
     void ReadHighScore();
     void WriteHighScore();
+    void WriteManifest() const;
 
     void StartPlayCurrentSong();
+    void EndPlayCurrentSong();
+    void StartInputSampler();
+
+    bool MakeSongResident(Song* song);
+    void TrimResidentSongs();
 
     void UpdateForInput();
+    void UpdateForEndOfSong();
     void UpdateForSong();
 
     void RenderForEnding(AABB2 const& bounds, std::vector<Vertex_PCU>& textVerts) const;
@@ -64,9 +75,17 @@ private:
 private:
     Game* m_game = nullptr;
     SongState m_songState = SONG_NULL;
+    std::atomic<FMOD_CHANNELCONTROL*> m_endedChannel = nullptr;  //set by the FMOD callback thread
     Timer* m_timer = nullptr;
 
+    std::string m_musicFolderPath;
     std::vector<Song*> m_songs;
     Song* m_currentSong = nullptr;
     unsigned int m_currentSongIndex = 0;
+
+    std::vector<Song*> m_residentSongs;  //songs with notes loaded, least recently used first
+    size_t m_residencyCap = 2;
+
+    InputSampler m_inputSampler;    //only runs while a song plays
+    int m_inputSampleRate = 1000;   //0 falls back to per frame input
 };
\ No newline at end of file
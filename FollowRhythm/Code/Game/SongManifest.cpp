@@ -0,0 +1,163 @@
+#include "Game/SongManifest.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+static const char sManifestDelimiter = '\t';
+static const char* sManifestTag = "FollowRhythmManifest";
+
+//////////////////////////////////////////////////////////////////////////
+static std::string GetFieldSafeText(std::string const& text)
+{
+    std::string result = text;
+    for (char& c : result) {
+        if (c == sManifestDelimiter || c == '\n' || c == '\r') {
+            c = ' ';
+        }
+    }
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void SplitManifestLine(std::string const& line, std::vector<std::string>& outFields)
+{
+    outFields.clear();
+    std::string field;
+    std::istringstream stream(line);
+    while (std::getline(stream, field, sManifestDelimiter)) {
+        outFields.push_back(field);
+    }
+    if (!line.empty() && line.back() == sManifestDelimiter) {
+        outFields.push_back("");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool ParseStamp(std::string const& sizeText, std::string const& timeText, FileStamp& outStamp)
+{
+    try {
+        outStamp.size = std::stoull(sizeText);
+        outStamp.writeTime = std::stoll(timeText);
+    }
+    catch (...) {
+        return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void WriteStamp(std::ostream& stream, FileStamp const& stamp)
+{
+    stream << stamp.size << sManifestDelimiter << stamp.writeTime;
+}
+
+//////////////////////////////////////////////////////////////////////////
+SongManifestEntry const* SongManifest::FindEntry(std::string const& songFilePath) const
+{
+    for (SongManifestEntry const& entry : entries) {
+        if (entry.songFilePath == songFilePath) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+FileStamp GetFileStamp(std::string const& filePath)
+{
+    FileStamp stamp;
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(filePath, error);
+    if (error) {
+        return stamp;
+    }
+    stamp.writeTime = (int64_t)writeTime.time_since_epoch().count();
+
+    if (std::filesystem::is_regular_file(filePath, error)) {
+        stamp.size = (uint64_t)std::filesystem::file_size(filePath, error);
+        if (error) {
+            stamp.size = 0;
+        }
+    }
+    return stamp;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ReadSongManifest(std::string const& manifestPath, SongManifest& outManifest)
+{
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    std::vector<std::string> fields;
+    if (!std::getline(file, line)) {
+        return false;
+    }
+    SplitManifestLine(line, fields);
+    if (fields.size() != 2 || fields[0] != sManifestTag || fields[1] != std::to_string(SONG_MANIFEST_VERSION)) {
+        return false;
+    }
+
+    while (std::getline(file, line)) {
+        SplitManifestLine(line, fields);
+        if (fields.size() != 18) {
+            continue;
+        }
+
+        SongManifestEntry entry;
+        entry.songFilePath = fields[0];
+        if (!ParseStamp(fields[1], fields[2], entry.soundStamp) ||
+            !ParseStamp(fields[3], fields[4], entry.infoStamp) ||
+            !ParseStamp(fields[5], fields[6], entry.notesStamp)) {
+            continue;
+        }
+        try {
+            entry.noteCount = (uint32_t)std::stoul(fields[7]);
+            entry.chartHash = std::stoull(fields[8], nullptr, 16);
+        }
+        catch (...) {
+            continue;
+        }
+        entry.isValid = fields[9] == "1";
+        entry.name = fields[10];
+        entry.author = fields[11];
+        entry.album = fields[12];
+        entry.link = fields[13];
+        entry.genres = fields[14];
+        entry.length = fields[15];
+        entry.difficulty = fields[16];
+        entry.background = fields[17];
+        outManifest.entries.push_back(entry);
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool WriteSongManifest(std::string const& manifestPath, SongManifest const& manifest)
+{
+    std::ofstream file(manifestPath, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char const d = sManifestDelimiter;
+    file << sManifestTag << d << SONG_MANIFEST_VERSION << '\n';
+
+    for (SongManifestEntry const& entry : manifest.entries) {
+        file << GetFieldSafeText(entry.songFilePath) << d;
+        WriteStamp(file, entry.soundStamp);
+        file << d;
+        WriteStamp(file, entry.infoStamp);
+        file << d;
+        WriteStamp(file, entry.notesStamp);
+        file << d << entry.noteCount << d << std::hex << entry.chartHash << std::dec << d;
+        file << (entry.isValid ? 1 : 0) << d;
+        file << GetFieldSafeText(entry.name) << d << GetFieldSafeText(entry.author) << d
+            << GetFieldSafeText(entry.album) << d << GetFieldSafeText(entry.link) << d
+            << GetFieldSafeText(entry.genres) << d << GetFieldSafeText(entry.length) << d
+            << GetFieldSafeText(entry.difficulty) << d << GetFieldSafeText(entry.background) << '\n';
+    }
+    return file.good();
+}
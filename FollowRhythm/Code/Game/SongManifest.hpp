@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+constexpr int SONG_MANIFEST_VERSION = 3;
+
+//size and last write time, enough to tell a file changed without reading it
+struct FileStamp
+{
+    uint64_t size = 0;
+    int64_t  writeTime = 0;
+
+    bool operator==(FileStamp const& other) const { return size == other.size && writeTime == other.writeTime; }
+    bool operator!=(FileStamp const& other) const { return !(*this == other); }
+};
+
+struct SongManifestEntry
+{
+    std::string songFilePath;
+    FileStamp soundStamp;
+    FileStamp infoStamp;
+    FileStamp notesStamp;   //the notes csv the chart cache below was taken from
+
+    std::string name;
+    std::string author;
+    std::string album;
+    std::string link;
+    std::string genres;
+    std::string length;
+    std::string difficulty;
+    std::string background;
+
+    uint32_t noteCount = 0;
+    uint64_t chartHash = 0;     //0 until the chart was loaded once
+
+    bool isValid = true;    //invalid songs are kept so they stay listed, their info is always reread
+};
+
+//cached song info and chart summary, the song list itself always comes from scanning the music folder
+struct SongManifest
+{
+    std::vector<SongManifestEntry> entries;
+
+    SongManifestEntry const* FindEntry(std::string const& songFilePath) const;
+};
+
+FileStamp GetFileStamp(std::string const& filePath);    //zero stamp if missing
+
+bool ReadSongManifest(std::string const& manifestPath, SongManifest& outManifest);
+bool WriteSongManifest(std::string const& manifestPath, SongManifest const& manifest);
@@ -0,0 +1,126 @@
+#include "Game/SongSimulation.hpp"
+#include "Game/SongTimeline.hpp"
+#include "Game/GameplayTicker.hpp"
+
+//counts what the ticker pulls out of the real source
+class CountingInputSource : public GameplayInputSource
+{
+public:
+    CountingInputSource(GameplayInputSource& input) : m_input(input) {}
+
+    bool PopInput(uint32_t untilMS, GameplayInputEvent& outInput) override
+    {
+        bool isPopped = m_input.PopInput(untilMS, outInput);
+        m_count += isPopped ? 1 : 0;
+        return isPopped;
+    }
+
+    uint32_t GetCount() const { return m_count; }
+
+private:
+    GameplayInputSource& m_input;
+    uint32_t m_count = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+FixedStepTimeSource::FixedStepTimeSource(uint32_t stepMS, uint32_t endMS)
+    : m_stepMS(stepMS == 0 ? 1 : stepMS)
+    , m_endMS(endMS)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool FixedStepTimeSource::GetNextTimeMS(uint32_t& outTimeMS)
+{
+    if (m_isDone) {
+        return false;
+    }
+
+    //always land exactly on the end so the last notes retire
+    if (m_nextMS >= m_endMS) {
+        outTimeMS = m_endMS;
+        m_isDone = true;
+        return true;
+    }
+    outTimeMS = m_nextMS;
+    m_nextMS += m_stepMS;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool EmptyInputSource::PopInput(uint32_t untilMS, GameplayInputEvent& outInput)
+{
+    (void)untilMS;
+    (void)outInput;
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BufferedInputSource::Push(GameplayInputEvent const& input)
+{
+    m_inputs.push_back(input);
+    if (m_inputs.size() > m_nextInput + 1) {
+        uint32_t lastMS = m_inputs[m_inputs.size() - 2].timeMS;
+        m_inputs.back().timeMS = input.timeMS < lastMS ? lastMS : input.timeMS;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BufferedInputSource::Clear()
+{
+    m_inputs.clear();
+    m_nextInput = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool BufferedInputSource::PopInput(uint32_t untilMS, GameplayInputEvent& outInput)
+{
+    if (m_nextInput >= m_inputs.size() || m_inputs[m_nextInput].timeMS > untilMS) {
+        if (m_nextInput >= m_inputs.size()) {
+            Clear();
+        }
+        return false;
+    }
+    outInput = m_inputs[m_nextInput++];
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+SongSimulationStats SimulateSong(SongTimeline& timeline, SongTimeSource& clock, GameplayInputSource& input,
+    GameplayTicker* ticker)
+{
+    SongSimulationStats stats;
+    timeline.BeginPlay();
+
+    if (ticker != nullptr) {
+        CountingInputSource countedInput(input);
+        ticker->Reset(0);
+        uint32_t timeMS = 0;
+        while (clock.GetNextTimeMS(timeMS)) {
+            ticker->TickTo(timeline, timeMS, countedInput);
+            stats.stepCount++;
+            stats.endMS = timeMS;
+        }
+        ticker->FinishAt(timeline, stats.endMS, countedInput);
+        stats.inputCount = countedInput.GetCount();
+        timeline.EndPlay();
+        return stats;
+    }
+
+    //same order as a frame in game: input judged first, then notes that are over retire
+    uint32_t timeMS = 0;
+    while (clock.GetNextTimeMS(timeMS)) {
+        GameplayInputEvent event;
+        while (input.PopInput(timeMS, event)) {
+            timeline.PushInput(event);
+            stats.inputCount++;
+        }
+        timeline.DispatchInput();
+        timeline.AdvanceTo(timeMS);
+        stats.stepCount++;
+        stats.endMS = timeMS;
+    }
+
+    timeline.EndPlay();
+    return stats;
+}
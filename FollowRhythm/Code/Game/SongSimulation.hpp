@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Game/GameplayInput.hpp"
+
+class SongTimeline;
+class GameplayTicker;
+
+//song time for a simulation, false once the song is over
+class SongTimeSource
+{
+public:
+    virtual ~SongTimeSource() = default;
+    virtual bool GetNextTimeMS(uint32_t& outTimeMS) = 0;
+};
+
+//gameplay input for a simulation, events come out in time order
+class GameplayInputSource
+{
+public:
+    virtual ~GameplayInputSource() = default;
+    virtual bool PopInput(uint32_t untilMS, GameplayInputEvent& outInput) = 0;  //next event at or before untilMS
+};
+
+//frame-like steps from 0 through endMS
+class FixedStepTimeSource : public SongTimeSource
+{
+public:
+    FixedStepTimeSource(uint32_t stepMS, uint32_t endMS);
+    bool GetNextTimeMS(uint32_t& outTimeMS) override;
+
+private:
+    uint32_t m_stepMS = 16;
+    uint32_t m_endMS = 0;
+    uint32_t m_nextMS = 0;
+    bool m_isDone = false;
+};
+
+//nobody playing, every note misses
+class EmptyInputSource : public GameplayInputSource
+{
+public:
+    bool PopInput(uint32_t untilMS, GameplayInputEvent& outInput) override;
+};
+
+//input collected ahead of the ticks that judge it, the game fills it from the sampler every frame
+class BufferedInputSource : public GameplayInputSource
+{
+public:
+    void Push(GameplayInputEvent const& input);     //kept in time order, an earlier time is moved up to the last one
+    void Clear();
+    bool PopInput(uint32_t untilMS, GameplayInputEvent& outInput) override;
+
+    size_t GetPendingCount() const { return m_inputs.size() - m_nextInput; }
+
+private:
+    std::vector<GameplayInputEvent> m_inputs;
+    size_t m_nextInput = 0;
+};
+
+struct SongSimulationStats
+{
+    uint32_t stepCount = 0;
+    uint32_t inputCount = 0;
+    uint32_t endMS = 0;
+};
+
+//plays the whole timeline as fast as the sources allow, the score is left in the timeline's ScoreKeeper
+//with a ticker every clock step is a frame that runs the gameplay ticks under it, the way the game does
+SongSimulationStats SimulateSong(SongTimeline& timeline, SongTimeSource& clock, GameplayInputSource& input,
+    GameplayTicker* ticker = nullptr);
@@ -0,0 +1,189 @@
+#include "Game/SongTimeline.hpp"
+#include "Game/ChartFile.hpp"
+#include "Game/ReplayFile.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::Build(ChartNoteRecord const* records, uint32_t noteCount)
+{
+    Release();
+
+    //one block for the whole chart and a play session, a long session cycling songs keeps the heap flat
+    m_noteArena.Reserve(NoteTable::GetChartBytes(noteCount) + NoteTable::GetPlayStateBytes(noteCount) +
+        sizeof(uint32_t) * 7 * (size_t)noteCount);   //hold index, lanes, and the window rounded up to a power of two
+    m_noteTable.Build(records, noteCount, m_noteArena);
+    m_holdIndex.Init(m_noteTable, m_noteArena);
+    m_judgement.Init(m_noteTable, m_noteArena);
+    m_activeNotes.Init(m_noteTable, m_noteArena);
+    m_playStateMarker = m_noteArena.GetMarker();
+    m_noteTable.AllocatePlayState(m_noteArena);
+    m_chartHash = HashChartRecords(records, noteCount);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::Release()
+{
+    m_noteTable.Clear();
+    m_noteArena.Release();
+    m_playStateMarker = ArenaMarker();
+    m_holdIndex.Clear();
+    m_judgement.Clear();
+    m_activeNotes.Clear();
+    m_scoreKeeper.Reset();
+    m_input.Clear();
+    m_elapsedMS = 0;
+    m_chartHash = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::BeginPlay()
+{
+    m_noteArena.RewindToMarker(m_playStateMarker);
+    m_noteTable.AllocatePlayState(m_noteArena);
+    m_scoreKeeper.Reset();
+    m_input.Clear();
+    m_elapsedMS = 0;
+    m_activeNotes.Reset();
+    m_judgement.Reset();
+    if (m_recorder != nullptr) {
+        m_recorder->Begin(m_noteTable.count, m_chartHash, m_pressDelayMS);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::EndPlay()
+{
+    m_scoreKeeper.BreakCombo();
+    if (m_recorder != nullptr) {
+        m_recorder->End(m_scoreKeeper);
+    }
+    ResetActiveNotes();
+    m_input.Clear();
+    m_elapsedMS = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::Seek(uint32_t timeMS)
+{
+    //notes outside the window are always clean, only the old window needs its hit state reset
+    if (m_recorder != nullptr) {
+        m_recorder->RecordSeek(timeMS);
+    }
+    ResetActiveNotes();
+    m_input.Clear();
+    m_elapsedMS = timeMS;
+    m_activeNotes.Seek(m_noteTable, m_holdIndex, timeMS);
+    m_judgement.Seek(timeMS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::PushInput(GameplayInputEvent const& input)
+{
+    if (m_input.GetCount() == GAMEPLAY_INPUT_QUEUE_SIZE) {
+        DispatchInput();
+    }
+    m_input.Push(input);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::DispatchInput()
+{
+    for (size_t i = 0; i < m_input.GetCount(); i++) {
+        GameplayInputEvent const& input = m_input[i];
+        if (m_recorder != nullptr) {
+            m_recorder->RecordInput(input);
+        }
+        if (input.type == GAMEPLAY_INPUT_BUTTON_PRESSED) {
+            HandleButtonPressed(input);
+        }
+        else {
+            HandleStickMoved(input);
+        }
+    }
+    m_input.Clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::AdvanceTo(uint32_t timeMS)
+{
+    if (m_recorder != nullptr) {
+        m_recorder->RecordAdvance(timeMS);
+    }
+    m_elapsedMS = timeMS;
+
+    //clean out outdated current notes, the ring keeps tombstones until the front is clear
+    uint32_t const* renderEnds = m_noteTable.renderEndMS;
+    size_t slotCount = m_activeNotes.GetSlotCount();
+    for (size_t slot = 0; slot < slotCount; slot++) {
+        uint32_t noteIndex = m_activeNotes.GetNoteInSlot(slot);
+        if (noteIndex == ACTIVE_NOTE_TOMBSTONE || renderEnds[noteIndex] > timeMS) {
+            continue;
+        }
+
+        if (!m_noteTable.IsScored(noteIndex)) {
+            m_scoreKeeper.BreakCombo();
+        }
+        Judgement judgement;
+        if (m_noteTable.IsHold(noteIndex) && JudgementEngine::JudgeHoldEnd(m_noteTable, noteIndex, timeMS, judgement)) {
+            ReportJudgement(judgement);
+        }
+        m_noteTable.ResetPlayState(noteIndex);
+        m_activeNotes.RetireSlot(slot);
+    }
+    m_activeNotes.TrimRetired();
+
+    //push in new current notes
+    m_activeNotes.SpawnNewNotes(m_noteTable, timeMS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32_t SongTimeline::GetEndMS() const
+{
+    uint32_t endMS = 0;
+    for (uint32_t i = 0; i < m_noteTable.count; i++) {
+        endMS = m_noteTable.renderEndMS[i] > endMS ? m_noteTable.renderEndMS[i] : endMS;
+    }
+    return endMS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::ResetActiveNotes()
+{
+    for (size_t slot = 0; slot < m_activeNotes.GetSlotCount(); slot++) {
+        uint32_t noteIndex = m_activeNotes.GetNoteInSlot(slot);
+        if (noteIndex != ACTIVE_NOTE_TOMBSTONE) {
+            m_noteTable.ResetPlayState(noteIndex);
+        }
+    }
+    m_activeNotes.Reset();
+    m_judgement.Reset();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::HandleButtonPressed(GameplayInputEvent const& input)
+{
+    Judgement judgement;
+    if (m_judgement.JudgePress(m_noteTable, input.isLeft, input.timeMS, m_pressDelayMS, judgement)) {
+        ReportJudgement(judgement);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::HandleStickMoved(GameplayInputEvent const& input)
+{
+    Judgement judgements[2];
+    size_t judgementCount = m_judgement.JudgeStick(m_noteTable, input.isLeft, input.yValue, input.timeMS, judgements);
+    for (size_t i = 0; i < judgementCount; i++) {
+        ReportJudgement(judgements[i]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void SongTimeline::ReportJudgement(Judgement const& judgement)
+{
+    if (judgement.IsScored()) {
+        m_scoreKeeper.AddScore(judgement);
+    }
+    if (m_listener != nullptr) {
+        m_listener->OnJudgement(judgement);
+    }
+}
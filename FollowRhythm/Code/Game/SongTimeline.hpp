@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Game/NoteTable.hpp"
+#include "Game/MonotonicArena.hpp"
+#include "Game/ActiveNoteWindow.hpp"
+#include "Game/HoldIntervalIndex.hpp"
+#include "Game/GameplayInput.hpp"
+#include "Game/JudgementEngine.hpp"
+#include "Game/ScoreKeeper.hpp"
+
+struct ChartNoteRecord;
+class ReplayRecorder;
+
+//told about every judgement once the timeline has scored it, effects and feedback hang off this
+class SongTimelineListener
+{
+public:
+    virtual ~SongTimelineListener() = default;
+    virtual void OnJudgement(Judgement const& judgement) = 0;
+};
+
+//the playable part of a song with no platform behind it: notes, visible window, judgement and score
+//time and input are pushed in from outside, the game feeds FMOD and the controller, a simulation feeds anything
+class SongTimeline
+{
+public:
+    SongTimeline() = default;
+    SongTimeline(SongTimeline const&) = delete;
+    SongTimeline& operator=(SongTimeline const&) = delete;
+
+    void Build(ChartNoteRecord const* records, uint32_t noteCount);
+    void Release();
+
+    void SetListener(SongTimelineListener* listener) { m_listener = listener; }
+    void SetPressDelayMS(float delayMS)               { m_pressDelayMS = delayMS; }
+    void SetRecorder(ReplayRecorder* recorder)        { m_recorder = recorder; }   //from the next BeginPlay on
+
+    void BeginPlay();
+    void EndPlay();
+    void Seek(uint32_t timeMS);     //any time, forward or back
+
+    void PushInput(GameplayInputEvent const& input);   //queued until DispatchInput, flushes itself when full
+    void DispatchInput();
+    void AdvanceTo(uint32_t timeMS);                    //retires notes that are over, spawns the ones coming in
+
+    NoteTable&              GetNoteTable()              { return m_noteTable; }
+    NoteTable const&        GetNoteTable() const        { return m_noteTable; }
+    ActiveNoteWindow const& GetActiveNotes() const      { return m_activeNotes; }
+    ScoreKeeper const&      GetScoreKeeper() const      { return m_scoreKeeper; }
+    uint32_t                GetElapsedMS() const        { return m_elapsedMS; }
+    uint32_t                GetNoteCount() const        { return m_noteTable.count; }
+    uint64_t                GetChartHash() const        { return m_chartHash; }
+    ReplayRecorder*         GetRecorder() const         { return m_recorder; }
+    uint32_t                GetEndMS() const;           //last note off screen
+    size_t                  GetArenaBytes() const       { return m_noteArena.GetReservedBytes(); }
+
+private:
+    void ResetActiveNotes();
+    void HandleButtonPressed(GameplayInputEvent const& input);
+    void HandleStickMoved(GameplayInputEvent const& input);
+    void ReportJudgement(Judgement const& judgement);
+
+private:
+    MonotonicArena m_noteArena;     //chart first, play session state after m_playStateMarker
+    ArenaMarker m_playStateMarker;
+    NoteTable m_noteTable;
+    HoldIntervalIndex m_holdIndex;
+    JudgementEngine m_judgement;
+    ActiveNoteWindow m_activeNotes;
+    ScoreKeeper m_scoreKeeper;
+    GameplayInputQueue m_input;
+
+    SongTimelineListener* m_listener = nullptr;
+    ReplayRecorder* m_recorder = nullptr;
+    uint64_t m_chartHash = 0;
+    float m_pressDelayMS = 0.f;
+    uint32_t m_elapsedMS = 0;
+};
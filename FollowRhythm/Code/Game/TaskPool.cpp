@@ -0,0 +1,107 @@
+#include "Game/TaskPool.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+TaskPool::TaskPool(unsigned int workerCount)
+{
+    if (workerCount == 0) {
+        unsigned int coreCount = std::thread::hardware_concurrency();
+        workerCount = coreCount > 1 ? coreCount - 1 : 1;
+    }
+
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&TaskPool::WorkerMain, this);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isQuitting = true;
+    }
+    m_taskAdded.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TaskPool::Submit(Task const& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(task);
+        m_pendingCount++;
+    }
+    m_taskAdded.notify_one();
+    m_mainThreadWake.notify_one();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TaskPool::SubmitToMainThread(Task const& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_mainThreadTasks.push_back(task);
+        m_pendingCount++;
+    }
+    m_mainThreadWake.notify_one();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TaskPool::WaitForAllAndRunMainThreadTasks()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_pendingCount > 0) {
+        Task task;
+        if (!m_mainThreadTasks.empty()) {
+            task = m_mainThreadTasks.front();
+            m_mainThreadTasks.pop_front();
+        }
+        else if (!m_tasks.empty()) {
+            task = m_tasks.front();
+            m_tasks.pop_front();
+        }
+        else {
+            m_mainThreadWake.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        task();
+        lock.lock();
+        m_pendingCount--;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TaskPool::WorkerMain()
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskAdded.wait(lock, [this]() { return m_isQuitting || !m_tasks.empty(); });
+            if (m_tasks.empty()) {  //quitting
+                return;
+            }
+            task = m_tasks.front();
+            m_tasks.pop_front();
+        }
+
+        task();
+        FinishTask();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TaskPool::FinishTask()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingCount--;
+    }
+    m_mainThreadWake.notify_one();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::function<void()> Task;
+
+//worker threads plus a main thread queue for work that has to stay on the main thread (GPU uploads)
+//tasks express dependencies by submitting their continuations when they finish
+class TaskPool
+{
+public:
+    explicit TaskPool(unsigned int workerCount = 0);    //0 picks hardware concurrency - 1
+    ~TaskPool();
+
+    void Submit(Task const& task);
+    void SubmitToMainThread(Task const& task);
+
+    //main thread helps with worker tasks while waiting, returns when every submitted task has run
+    void WaitForAllAndRunMainThreadTasks();
+
+    unsigned int GetWorkerCount() const { return (unsigned int)m_workers.size(); }
+
+private:
+    void WorkerMain();
+    void FinishTask();
+
+private:
+    std::vector<std::thread> m_workers;
+    std::deque<Task> m_tasks;
+    std::deque<Task> m_mainThreadTasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::condition_variable m_mainThreadWake;
+    size_t m_pendingCount = 0;
+    bool m_isQuitting = false;
+};
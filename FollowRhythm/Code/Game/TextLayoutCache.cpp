@@ -0,0 +1,87 @@
+#include "Game/TextLayoutCache.hpp"
+
+//////////////////////////////////////////////////////////////////////////
+static void HashBytes(uint64_t& hash, void const* data, size_t byteCount)
+{
+    uint8_t const* bytes = (uint8_t const*)data;
+    for (size_t i = 0; i < byteCount; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+TextLayoutCache::TextLayoutCache(BitmapFont* font)
+    : m_font(font)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TextLayoutCache::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& verts, AABB2 const& box, float cellHeight,
+    std::string const& text, Rgba8 const& tint, float cellAspect, Vec2 const& alignment, float spacing, float kerning)
+{
+    uint64_t hash = GetLayoutHash(box, cellHeight, text, tint, cellAspect, alignment, spacing, kerning);
+    TextLayout& layout = m_layouts[hash];
+    bool isSame = layout.lastUsedFrame != 0 && layout.text == text && layout.cellHeight == cellHeight && layout.tint == tint &&
+        layout.box.mins.x == box.mins.x && layout.box.mins.y == box.mins.y && layout.box.maxs.x == box.maxs.x &&
+        layout.box.maxs.y == box.maxs.y && layout.cellAspect == cellAspect && layout.alignment.x == alignment.x &&
+        layout.alignment.y == alignment.y && layout.spacing == spacing && layout.kerning == kerning;
+    if (!isSame) {
+        layout.text = text;
+        layout.box = box;
+        layout.cellHeight = cellHeight;
+        layout.tint = tint;
+        layout.cellAspect = cellAspect;
+        layout.alignment = alignment;
+        layout.spacing = spacing;
+        layout.kerning = kerning;
+        layout.verts.clear();
+        m_font->AddVertsForTextInBox2D(layout.verts, box, cellHeight, text, tint, cellAspect, alignment, spacing, kerning);
+        m_missCount++;
+    }
+    else {
+        m_hitCount++;
+    }
+
+    layout.lastUsedFrame = m_frame + 1;     //0 marks a layout that was never built
+    verts.insert(verts.end(), layout.verts.begin(), layout.verts.end());
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TextLayoutCache::EndFrame()
+{
+    m_frame++;
+    if (m_frame % TEXT_LAYOUT_MAX_IDLE_FRAMES != 0) {
+        return;
+    }
+
+    //calibration numbers, song info and the like leave old layouts behind
+    for (auto iter = m_layouts.begin(); iter != m_layouts.end();) {
+        if (m_frame + 1 - iter->second.lastUsedFrame > TEXT_LAYOUT_MAX_IDLE_FRAMES) {
+            iter = m_layouts.erase(iter);
+        }
+        else {
+            iter++;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void TextLayoutCache::Clear()
+{
+    m_layouts.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint64_t TextLayoutCache::GetLayoutHash(AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint,
+    float cellAspect, Vec2 const& alignment, float spacing, float kerning)
+{
+    uint64_t hash = 14695981039346656037ull;
+    HashBytes(hash, text.data(), text.size());
+    float values[10] = { box.mins.x, box.mins.y, box.maxs.x, box.maxs.y, cellHeight, cellAspect,
+        alignment.x, alignment.y, spacing, kerning };
+    HashBytes(hash, values, sizeof(values));
+    unsigned char color[4] = { tint.r, tint.g, tint.b, tint.a };
+    HashBytes(hash, color, sizeof(color));
+    return hash;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+
+constexpr uint32_t TEXT_LAYOUT_MAX_IDLE_FRAMES = 120;  //layouts not drawn for this long are dropped
+
+//glyph quads of text that rarely changes, laid out by the font once and copied out every frame after
+//a layout is keyed by every argument of the font call, new text or a resized window is simply a new layout
+class TextLayoutCache
+{
+public:
+    explicit TextLayoutCache(BitmapFont* font);
+
+    //same arguments as BitmapFont
+    void AddVertsForTextInBox2D(std::vector<Vertex_PCU>& verts, AABB2 const& box, float cellHeight, std::string const& text,
+        Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f, Vec2 const& alignment = ALIGN_CENTERED,
+        float spacing = 0.f, float kerning = 0.f);
+    void EndFrame();
+    void Clear();
+
+    size_t   GetLayoutCount() const { return m_layouts.size(); }
+    uint32_t GetHitCount() const    { return m_hitCount; }
+    uint32_t GetMissCount() const   { return m_missCount; }
+
+private:
+    struct TextLayout
+    {
+        std::string text;
+        AABB2 box;
+        float cellHeight = 0.f;
+        Rgba8 tint;
+        float cellAspect = 1.f;
+        Vec2 alignment;
+        float spacing = 0.f;
+        float kerning = 0.f;
+        std::vector<Vertex_PCU> verts;
+        uint32_t lastUsedFrame = 0;
+    };
+
+    static uint64_t GetLayoutHash(AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint,
+        float cellAspect, Vec2 const& alignment, float spacing, float kerning);
+
+private:
+    BitmapFont* m_font = nullptr;
+    std::unordered_map<uint64_t, TextLayout> m_layouts;     //by hash, a clash just lays the text out again
+    uint32_t m_frame = 0;
+    uint32_t m_hitCount = 0;
+    uint32_t m_missCount = 0;
+};
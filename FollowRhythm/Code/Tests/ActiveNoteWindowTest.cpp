@@ -0,0 +1,107 @@
+//checks ActiveNoteWindow::Seek and the JudgementEngine::Seek lane cursors against a brute force scan
+//of the note table at many times
+#include "Game/ActiveNoteWindow.hpp"
+#include "Game/ChartFile.hpp"
+#include "Game/HoldIntervalIndex.hpp"
+#include "Game/JudgementEngine.hpp"
+#include "Game/MonotonicArena.hpp"
+#include "Game/NoteTable.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+static std::vector<ChartNoteRecord> MakeChart(uint32_t noteCount, int holdPercent, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<ChartNoteRecord> records(noteCount);
+    uint32_t timeMS = 1000;
+    for (ChartNoteRecord& record : records) {
+        timeMS += rng() % 700;
+        record.startMS = timeMS;
+        if ((int)(rng() % 100) < holdPercent) {
+            record.duration = 100 + rng() % 4000;
+        }
+        record.flags = (uint8_t)(rng() % 4);
+    }
+    return records;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static uint32_t CountMismatches(char const* name, std::vector<ChartNoteRecord> const& records)
+{
+    MonotonicArena arena;
+    NoteTable table;
+    HoldIntervalIndex holds;
+    ActiveNoteWindow window;
+    JudgementEngine judgement;
+    table.Build(records.data(), (uint32_t)records.size(), arena);
+    holds.Init(table, arena);
+    window.Init(table, arena);
+    judgement.Init(table, arena);
+
+    uint32_t lastMS = table.count > 0 ? table.startMS[table.count - 1] + 5000 : 0;
+    uint32_t sampleCount = 0;
+    uint32_t mismatchCount = 0;
+    uint32_t cursorMismatchCount = 0;
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> actual;
+    for (uint32_t timeMS = 0; timeMS <= lastMS; timeMS += 37) {
+        expected.clear();
+        for (uint32_t i = 0; i < table.count; i++) {
+            if (table.renderBeginMS[i] <= timeMS && timeMS < table.renderEndMS[i]) {
+                expected.push_back(i);
+            }
+        }
+
+        window.Seek(table, holds, timeMS);
+        actual.clear();
+        for (size_t slot = 0; slot < window.GetSlotCount(); slot++) {
+            actual.push_back(window.GetNoteInSlot(slot));
+        }
+        std::sort(actual.begin(), actual.end());
+
+        sampleCount++;
+        if (actual != expected) {
+            mismatchCount++;
+        }
+
+        //each lane cursor sits on the lane's first note still on screen
+        uint32_t expectedCursors[NUM_JUDGEMENT_LANES] = {};
+        bool isCursorFound[NUM_JUDGEMENT_LANES] = {};
+        for (uint32_t i = 0; i < table.count; i++) {
+            uint8_t lane = JudgementEngine::GetLaneForNote(table, i);
+            if (!isCursorFound[lane] && table.renderEndMS[i] > timeMS) {
+                isCursorFound[lane] = true;
+            }
+            else if (!isCursorFound[lane]) {
+                expectedCursors[lane]++;
+            }
+        }
+
+        judgement.Seek(timeMS);
+        for (uint8_t lane = 0; lane < NUM_JUDGEMENT_LANES; lane++) {
+            if (judgement.GetLaneCursor(lane) != expectedCursors[lane]) {
+                cursorMismatchCount++;
+                break;
+            }
+        }
+    }
+
+    printf("%-12s notes: %u  samples: %u  mismatches: %u  cursor mismatches: %u\n",
+        name, table.count, sampleCount, mismatchCount, cursorMismatchCount);
+    return mismatchCount + cursorMismatchCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+int main()
+{
+    uint32_t mismatchCount = 0;
+    mismatchCount += CountMismatches("singles", MakeChart(500, 0, 1));
+    mismatchCount += CountMismatches("holds", MakeChart(500, 100, 2));
+    mismatchCount += CountMismatches("mixed", MakeChart(500, 30, 3));
+    mismatchCount += CountMismatches("dense mixed", MakeChart(2000, 50, 4));
+    mismatchCount += CountMismatches("empty", std::vector<ChartNoteRecord>());
+    return mismatchCount == 0 ? 0 : 1;
+}
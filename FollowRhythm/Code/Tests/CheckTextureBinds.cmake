@@ -0,0 +1,21 @@
+# Game code binds textures only through BindTexture in GameCommon.cpp, with handles resolved at load.
+# Any other BindDiffuseTexture call, by path or not, skips that rule and fails this check.
+# usage: cmake -DGAME_DIR=<FollowRhythm/Code/Game> -P CheckTextureBinds.cmake
+
+file(GLOB sources ${GAME_DIR}/*.cpp ${GAME_DIR}/*.hpp)
+set(offenders "")
+foreach(source ${sources})
+    get_filename_component(sourceName ${source} NAME)
+    if(sourceName STREQUAL "GameCommon.cpp")
+        continue()
+    endif()
+    file(STRINGS ${source} lines REGEX "BindDiffuseTexture[ \t]*\\(")
+    if(lines)
+        list(APPEND offenders ${sourceName})
+    endif()
+endforeach()
+
+if(offenders)
+    list(JOIN offenders "\n" offenderText)
+    message(FATAL_ERROR "bind textures with BindTexture and a handle from AssetManager:\n${offenderText}")
+endif()
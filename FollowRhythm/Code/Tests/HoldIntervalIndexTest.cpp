@@ -0,0 +1,81 @@
+//checks HoldIntervalIndex::ForEachOverlap against a brute force scan of the hold notes for many ranges
+#include "Game/ChartFile.hpp"
+#include "Game/HoldIntervalIndex.hpp"
+#include "Game/MonotonicArena.hpp"
+#include "Game/NoteTable.hpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+static std::vector<ChartNoteRecord> MakeChart(uint32_t noteCount, int holdPercent, uint32_t maxGapMS, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<ChartNoteRecord> records(noteCount);
+    uint32_t timeMS = 1000;
+    for (ChartNoteRecord& record : records) {
+        timeMS += rng() % maxGapMS;
+        record.startMS = timeMS;
+        if ((int)(rng() % 100) < holdPercent) {
+            record.duration = 100 + rng() % 4000;
+        }
+        record.flags = (uint8_t)(rng() % 4);
+    }
+    return records;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static uint32_t CountMismatches(char const* name, std::vector<ChartNoteRecord> const& records)
+{
+    MonotonicArena arena;
+    NoteTable table;
+    HoldIntervalIndex holds;
+    table.Build(records.data(), (uint32_t)records.size(), arena);
+    holds.Init(table, arena);
+
+    std::mt19937 rng(table.count);
+    uint32_t lastMS = table.count > 0 ? table.startMS[table.count - 1] + 5000 : 1000;
+    uint32_t const widths[] = { 0, 1, 37, 500, 5000 };  //an empty range overlaps nothing
+    uint32_t queryCount = 0;
+    uint32_t mismatchCount = 0;
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> actual;
+    for (int sample = 0; sample < 4000; sample++) {
+        uint32_t beginMS = rng() % lastMS;
+        for (uint32_t width : widths) {
+            uint32_t endMS = beginMS + width;
+            expected.clear();
+            for (uint32_t i = 0; i < table.count; i++) {
+                if (table.IsHold(i) && beginMS < endMS && table.startMS[i] < endMS && beginMS < table.startMS[i] + table.duration[i]) {
+                    expected.push_back(i);
+                }
+            }
+
+            actual.clear();
+            holds.ForEachOverlap(beginMS, endMS, [&actual](uint32_t noteIndex) {
+                actual.push_back(noteIndex);
+            });
+
+            queryCount++;
+            if (actual != expected) {   //chart order, so no sort
+                mismatchCount++;
+            }
+        }
+    }
+
+    printf("%-12s holds: %u  queries: %u  mismatches: %u\n", name, holds.GetHoldCount(), queryCount, mismatchCount);
+    return mismatchCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+int main()
+{
+    uint32_t mismatchCount = 0;
+    mismatchCount += CountMismatches("one hold", MakeChart(1, 100, 700, 1));
+    mismatchCount += CountMismatches("holds", MakeChart(500, 100, 700, 2));
+    mismatchCount += CountMismatches("stacked", MakeChart(777, 100, 40, 3));
+    mismatchCount += CountMismatches("mixed", MakeChart(1000, 30, 700, 4));
+    mismatchCount += CountMismatches("singles", MakeChart(300, 0, 700, 5));
+    mismatchCount += CountMismatches("empty", std::vector<ChartNoteRecord>());
+    return mismatchCount == 0 ? 0 : 1;
+}